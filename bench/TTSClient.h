@@ -0,0 +1,90 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef _TTS_CLIENT_H_
+#define _TTS_CLIENT_H_
+
+/**
+ * Stand-in for the RDK TTSClient header, used by the benchmark driver only.
+ * Declares the subset of the TTSClient API librdkat uses; the implementation
+ * in tts_client_stub.cpp simulates TTSManager in process, see tts_stub.h.
+ */
+
+#include <stdint.h>
+
+#include <string>
+
+namespace TTS {
+
+enum TTS_Error {
+    TTS_OK = 0,
+    TTS_FAIL,
+    TTS_NOT_ENABLED,
+    TTS_INVALID_CONFIGURATION,
+    TTS_NO_ACCESS,
+    TTS_INVALID_SESSION
+};
+
+struct SpeechData {
+    SpeechData() : secure(false), id(0) {}
+    bool secure;
+    uint32_t id;
+    std::string text;
+};
+
+class TTSConnectionCallback {
+public:
+    virtual ~TTSConnectionCallback() {}
+    virtual void onTTSServerConnected() = 0;
+    virtual void onTTSServerClosed() = 0;
+    virtual void onTTSStateChanged(bool enabled) = 0;
+    virtual void onVoiceChanged(std::string) {}
+};
+
+class TTSSessionCallback {
+public:
+    virtual ~TTSSessionCallback() {}
+    virtual void onTTSSessionCreated(uint32_t appId, uint32_t sessionId) = 0;
+    virtual void onResourceAcquired(uint32_t appId, uint32_t sessionId) = 0;
+    virtual void onResourceReleased(uint32_t appId, uint32_t sessionId) = 0;
+    virtual void onSpeechStart(uint32_t appId, uint32_t sessionId, SpeechData &data) = 0;
+    virtual void onSpeechPause(uint32_t, uint32_t, uint32_t) {}
+    virtual void onSpeechResume(uint32_t, uint32_t, uint32_t) {}
+    virtual void onSpeechCancelled(uint32_t, uint32_t, uint32_t) {}
+    virtual void onSpeechInterrupted(uint32_t, uint32_t, uint32_t) {}
+    virtual void onNetworkError(uint32_t, uint32_t, uint32_t) {}
+    virtual void onPlaybackError(uint32_t, uint32_t, uint32_t) {}
+    virtual void onSpeechComplete(uint32_t appId, uint32_t sessionId, SpeechData &data) = 0;
+};
+
+class TTSClient {
+public:
+    static TTSClient *create(TTSConnectionCallback *connectionCallback, bool discardDuplicateCallbacks = false);
+    virtual ~TTSClient() {}
+
+    virtual bool isTTSEnabled(bool forcefetch = false) = 0;
+    virtual uint32_t createSession(uint32_t appId, std::string appName, TTSSessionCallback *sessionCallback) = 0;
+    virtual bool isActiveSession(uint32_t sessionId, bool forcefetch = false) = 0;
+    virtual TTS_Error speak(uint32_t sessionId, SpeechData &data) = 0;
+    virtual TTS_Error abort(uint32_t sessionId) = 0;
+    virtual TTS_Error destroySession(uint32_t sessionId) = 0;
+};
+
+} // namespace TTS
+
+#endif // _TTS_CLIENT_H_
@@ -0,0 +1,587 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+ * Synthetic benchmark of librdkat, see "make bench".
+ *
+ * Builds AtkObject trees (buttons, check boxes, a table, text fields),
+ * emits the signals RDK_AT::Initialize() subscribes to and reports, per
+ * scenario, the cost of an emission with rdkat attached minus the cost of
+ * the same emission without it: ns/event and heap allocations/event on the
+ * emitting thread. Then measures focus-to-speak latency, from the focus
+ * state change to the stub TTSClient's speak() call, and checks that a
+ * doubled letter typed into a field is echoed twice (exit status 1 if not).
+ *
+ * Usage: rdkat_bench [events per scenario (default 20000)] [focus changes (default 200)]
+ * TTS timings are set through the environment, see tts_stub.h.
+ * Allocation counting interposes glibc's malloc.
+ */
+
+#include "rdkat.h"
+#include "tts_stub.h"
+
+#include <atk/atk.h>
+#include <glib.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Allocation counting ---------------------------------------------------------
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+}
+
+static std::atomic<bool> gCountAllocations(false);
+static pthread_t gCountingThread;
+static uint64_t gAllocations = 0;
+
+static inline void countAllocation()
+{
+    if(gCountAllocations.load(std::memory_order_relaxed) && pthread_equal(pthread_self(), gCountingThread))
+        gAllocations++;
+}
+
+extern "C" void *malloc(size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void *memalign(size_t alignment, size_t size)
+{
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+    countAllocation();
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : ENOMEM;
+}
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Synthetic accessibles -------------------------------------------------------
+
+struct BenchObject {
+    AtkObject parent;
+    guint64 states;
+};
+
+struct BenchObjectClass {
+    AtkObjectClass parent_class;
+};
+
+G_DEFINE_TYPE(BenchObject, bench_object, ATK_TYPE_OBJECT)
+
+static AtkStateSet *bench_object_ref_state_set(AtkObject *obj)
+{
+    AtkStateSet *set = atk_state_set_new();
+    guint64 states = ((BenchObject*)obj)->states;
+    for(int s = 0; s < ATK_STATE_LAST_DEFINED; s++) {
+        if(states & (G_GUINT64_CONSTANT(1) << s))
+            atk_state_set_add_state(set, (AtkStateType)s);
+    }
+    return set;
+}
+
+static void bench_object_class_init(BenchObjectClass *klass)
+{
+    ATK_OBJECT_CLASS(klass)->ref_state_set = bench_object_ref_state_set;
+}
+
+static void bench_object_init(BenchObject *) {}
+
+struct BenchTable {
+    BenchObject parent;
+    gint rows;
+    gint columns;
+    AtkObject *caption;
+    std::vector<AtkObject*> *cells;
+};
+
+struct BenchTableClass {
+    BenchObjectClass parent_class;
+};
+
+static void bench_table_iface_init(AtkTableIface *iface);
+G_DEFINE_TYPE_WITH_CODE(BenchTable, bench_table, bench_object_get_type(),
+    G_IMPLEMENT_INTERFACE(ATK_TYPE_TABLE, bench_table_iface_init))
+
+static void bench_table_class_init(BenchTableClass *) {}
+static void bench_table_init(BenchTable *table)
+{
+    table->cells = new std::vector<AtkObject*>();
+}
+
+static gint bench_table_get_n_rows(AtkTable *table) { return ((BenchTable*)table)->rows; }
+static gint bench_table_get_n_columns(AtkTable *table) { return ((BenchTable*)table)->columns; }
+static AtkObject *bench_table_get_caption(AtkTable *table) { return ((BenchTable*)table)->caption; }
+
+static AtkObject *bench_table_ref_at(AtkTable *atkTable, gint row, gint column)
+{
+    BenchTable *table = (BenchTable*)atkTable;
+    if(row < 0 || column < 0 || row >= table->rows || column >= table->columns)
+        return NULL;
+    return ATK_OBJECT(g_object_ref((*table->cells)[row * table->columns + column]));
+}
+
+static void bench_table_iface_init(AtkTableIface *iface)
+{
+    iface->get_n_rows = bench_table_get_n_rows;
+    iface->get_n_columns = bench_table_get_n_columns;
+    iface->get_caption = bench_table_get_caption;
+    iface->ref_at = bench_table_ref_at;
+}
+
+struct BenchCell {
+    BenchObject parent;
+    AtkObject *table;
+    gint row;
+    gint column;
+};
+
+struct BenchCellClass {
+    BenchObjectClass parent_class;
+};
+
+static void bench_cell_iface_init(AtkTableCellIface *iface);
+G_DEFINE_TYPE_WITH_CODE(BenchCell, bench_cell, bench_object_get_type(),
+    G_IMPLEMENT_INTERFACE(ATK_TYPE_TABLE_CELL, bench_cell_iface_init))
+
+static void bench_cell_class_init(BenchCellClass *) {}
+static void bench_cell_init(BenchCell *) {}
+
+static gboolean bench_cell_get_position(AtkTableCell *atkCell, gint *row, gint *column)
+{
+    BenchCell *cell = (BenchCell*)atkCell;
+    *row = cell->row;
+    *column = cell->column;
+    return TRUE;
+}
+
+static AtkObject *bench_cell_get_table(AtkTableCell *cell)
+{
+    return ATK_OBJECT(g_object_ref(((BenchCell*)cell)->table));
+}
+
+static void bench_cell_iface_init(AtkTableCellIface *iface)
+{
+    iface->get_position = bench_cell_get_position;
+    iface->get_table = bench_cell_get_table;
+}
+
+struct BenchText {
+    BenchObject parent;
+    GString *text;
+    gint caret;
+};
+
+struct BenchTextClass {
+    BenchObjectClass parent_class;
+};
+
+static void bench_text_iface_init(AtkTextIface *iface);
+G_DEFINE_TYPE_WITH_CODE(BenchText, bench_text, bench_object_get_type(),
+    G_IMPLEMENT_INTERFACE(ATK_TYPE_TEXT, bench_text_iface_init))
+
+static void bench_text_class_init(BenchTextClass *) {}
+static void bench_text_init(BenchText *text)
+{
+    text->text = g_string_new("");
+}
+
+static gchar *bench_text_get_text(AtkText *atkText, gint start, gint end)
+{
+    BenchText *text = (BenchText*)atkText;
+    glong length = g_utf8_strlen(text->text->str, -1);
+    if(end < 0 || end > length)
+        end = length;
+    if(start < 0 || start > end)
+        start = end;
+    return g_utf8_substring(text->text->str, start, end);
+}
+
+static gint bench_text_get_character_count(AtkText *text)
+{
+    return g_utf8_strlen(((BenchText*)text)->text->str, -1);
+}
+
+static gint bench_text_get_caret_offset(AtkText *text)
+{
+    return ((BenchText*)text)->caret;
+}
+
+static void bench_text_iface_init(AtkTextIface *iface)
+{
+    iface->get_text = bench_text_get_text;
+    iface->get_character_count = bench_text_get_character_count;
+    iface->get_caret_offset = bench_text_get_caret_offset;
+}
+
+template <typename T>
+static T *newAccessible(GType type, AtkObject *parent, AtkRole role, const char *name)
+{
+    AtkObject *obj = ATK_OBJECT(g_object_new(type, NULL));
+    atk_object_set_role(obj, role);
+    if(name)
+        atk_object_set_name(obj, name);
+    if(parent)
+        atk_object_set_parent(obj, parent);
+    ((BenchObject*)obj)->states = (G_GUINT64_CONSTANT(1) << ATK_STATE_FOCUSABLE) | (G_GUINT64_CONSTANT(1) << ATK_STATE_SHOWING);
+    return (T*)obj;
+}
+
+static void setState(AtkObject *obj, AtkStateType state, bool value)
+{
+    guint64 bit = G_GUINT64_CONSTANT(1) << state;
+    BenchObject *bo = (BenchObject*)obj;
+    bo->states = value ? (bo->states | bit) : (bo->states & ~bit);
+    atk_object_notify_state_change(obj, state, value);
+}
+
+struct Tree {
+    AtkObject *document;
+    std::vector<AtkObject*> buttons;
+    std::vector<AtkObject*> checkBoxes;
+    BenchTable *table;
+    std::vector<BenchText*> textFields;
+};
+
+static void buildTree(Tree &tree)
+{
+    char name[64];
+    tree.document = newAccessible<AtkObject>(bench_object_get_type(), NULL, ATK_ROLE_DOCUMENT_WEB, "Bench");
+
+    for(int i = 0; i < 50; i++) {
+        snprintf(name, sizeof(name), "Button %d", i);
+        tree.buttons.push_back(newAccessible<AtkObject>(bench_object_get_type(), tree.document, ATK_ROLE_PUSH_BUTTON, name));
+        snprintf(name, sizeof(name), "Option %d", i);
+        tree.checkBoxes.push_back(newAccessible<AtkObject>(bench_object_get_type(), tree.document, ATK_ROLE_CHECK_BOX, name));
+    }
+
+    // 1000 cells
+    BenchTable *table = newAccessible<BenchTable>(bench_table_get_type(), tree.document, ATK_ROLE_TABLE, "Schedule");
+    table->rows = 100;
+    table->columns = 10;
+    table->caption = ATK_OBJECT(newAccessible<AtkObject>(bench_object_get_type(), ATK_OBJECT(table), ATK_ROLE_CAPTION, "Schedule"));
+    for(int r = 0; r < table->rows; r++) {
+        snprintf(name, sizeof(name), "Channel %d", r);
+        AtkObject *row = newAccessible<AtkObject>(bench_object_get_type(), ATK_OBJECT(table), ATK_ROLE_TABLE_ROW, name);
+        for(int c = 0; c < table->columns; c++) {
+            snprintf(name, sizeof(name), "Show %d.%d", r, c);
+            BenchCell *cell = newAccessible<BenchCell>(bench_cell_get_type(), row, ATK_ROLE_TABLE_CELL, name);
+            cell->table = ATK_OBJECT(table);
+            cell->row = r;
+            cell->column = c;
+            table->cells->push_back(ATK_OBJECT(cell));
+        }
+    }
+    tree.table = table;
+
+    for(int i = 0; i < 5; i++) {
+        snprintf(name, sizeof(name), "Search %d", i);
+        BenchText *text = newAccessible<BenchText>(bench_text_get_type(), tree.document, ATK_ROLE_ENTRY, name);
+        ((BenchObject*)text)->states |= G_GUINT64_CONSTANT(1) << ATK_STATE_EDITABLE;
+        tree.textFields.push_back(text);
+    }
+}
+
+// Scenarios -------------------------------------------------------------------
+
+struct Scenario {
+    const char *name;
+    const char *listener;
+    void (*emit)(Tree &tree, int i);
+    double baselineNs;
+    double baselineAllocs;
+    double ns;
+    double allocs;
+};
+
+static void emitFocus(Tree &tree, int i)
+{
+    AtkObject *prev = tree.buttons[(i + tree.buttons.size() - 1) % tree.buttons.size()];
+    AtkObject *next = tree.buttons[i % tree.buttons.size()];
+    setState(prev, ATK_STATE_FOCUSED, false);
+    setState(next, ATK_STATE_FOCUSED, true);
+}
+
+static void emitCellFocus(Tree &tree, int i)
+{
+    std::vector<AtkObject*> &cells = *tree.table->cells;
+    setState(cells[(i + cells.size() - 1) % cells.size()], ATK_STATE_FOCUSED, false);
+    setState(cells[i % cells.size()], ATK_STATE_FOCUSED, true);
+}
+
+static void emitChecked(Tree &tree, int i)
+{
+    AtkObject *obj = tree.checkBoxes[i % tree.checkBoxes.size()];
+    setState(obj, ATK_STATE_CHECKED, !(((BenchObject*)obj)->states & (G_GUINT64_CONSTANT(1) << ATK_STATE_CHECKED)));
+}
+
+static void emitShowing(Tree &tree, int i)
+{
+    setState(tree.buttons[i % tree.buttons.size()], ATK_STATE_SHOWING, i & 1);
+}
+
+static void emitNameChange(Tree &tree, int i)
+{
+    g_object_notify(G_OBJECT(tree.buttons[i % tree.buttons.size()]), "accessible-name");
+}
+
+static void emitChildAdded(Tree &tree, int i)
+{
+    g_signal_emit_by_name(tree.document, "children-changed::add", (guint)(i % 50), tree.buttons[i % tree.buttons.size()]);
+}
+
+static void emitRowInserted(Tree &tree, int i)
+{
+    g_signal_emit_by_name(tree.table, "row-inserted", (gint)(i % tree.table->rows), (gint)1);
+}
+
+static void emitTextInsert(Tree &tree, int i)
+{
+    BenchText *text = tree.textFields[i % tree.textFields.size()];
+    if(text->text->len > 64) {
+        gint length = g_utf8_strlen(text->text->str, -1);
+        g_string_truncate(text->text, 0);
+        g_signal_emit_by_name(text, "text-remove::system", (gint)0, length, "");
+        text->caret = 0;
+    }
+
+    const char *typed = (i % 6 == 5) ? " " : "a";
+    g_string_insert(text->text, text->caret, typed);
+    g_signal_emit_by_name(text, "text-insert::system", text->caret, (gint)1, typed);
+    text->caret++;
+    g_signal_emit_by_name(text, "text-caret-moved", text->caret);
+}
+
+static void pump(guint ms)
+{
+    uint64_t end = nowNs() + ms * 1000000ULL;
+    do {
+        while(g_main_context_iteration(NULL, FALSE)) { }
+        g_usleep(500);
+    } while(nowNs() < end);
+}
+
+static void runScenario(Tree &tree, Scenario &s, int events, double &ns, double &allocs)
+{
+    for(int i = 0; i < 100; i++)
+        s.emit(tree, i);
+    pump(5);
+
+    gAllocations = 0;
+    gCountingThread = pthread_self();
+    gCountAllocations = true;
+    uint64_t start = nowNs();
+    for(int i = 0; i < events; i++)
+        s.emit(tree, i);
+    uint64_t elapsed = nowNs() - start;
+    gCountAllocations = false;
+
+    ns = (double)elapsed / events;
+    allocs = (double)gAllocations / events;
+    pump(100);
+}
+
+// Focus to speak latency ------------------------------------------------------
+
+static std::mutex gSpeakMutex;
+static std::string gExpected;
+static std::atomic<uint64_t> gSpokenAt(0);
+static std::vector<std::string> gSpoken;
+static bool gRecordSpoken = false;
+
+static void SpeakObserved(const std::string &text, void *)
+{
+    std::lock_guard<std::mutex> lock(gSpeakMutex);
+    if(gRecordSpoken)
+        gSpoken.push_back(text);
+    if(!gExpected.empty() && text.compare(0, gExpected.size(), gExpected) == 0) {
+        gSpokenAt = nowNs();
+        gExpected.clear();
+    }
+}
+
+// Typing echo ----------------------------------------------------------------
+
+// Types "ll" into a focused field, both letters must be echoed
+static bool checkDoubledLetter(Tree &tree, AtkObject *focused)
+{
+    BenchText *text = tree.textFields[0];
+    setState(focused, ATK_STATE_FOCUSED, false);
+    setState(ATK_OBJECT(text), ATK_STATE_FOCUSED, true);
+    pump(500);
+
+    {
+        std::lock_guard<std::mutex> lock(gSpeakMutex);
+        gSpoken.clear();
+        gRecordSpoken = true;
+    }
+    for(int i = 0; i < 2; i++) {
+        g_string_insert(text->text, text->caret, "l");
+        g_signal_emit_by_name(text, "text-insert::system", text->caret, (gint)1, "l");
+        text->caret++;
+        g_signal_emit_by_name(text, "text-caret-moved", text->caret);
+        pump(50);
+    }
+    pump(200);
+
+    std::lock_guard<std::mutex> lock(gSpeakMutex);
+    gRecordSpoken = false;
+    return std::count(gSpoken.begin(), gSpoken.end(), std::string("l")) == 2;
+}
+
+static double percentile(std::vector<double> &sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+int main(int argc, char *argv[])
+{
+    int events = argc > 1 ? atoi(argv[1]) : 20000;
+    int focusChanges = argc > 2 ? atoi(argv[2]) : 200;
+    if(events <= 0 || focusChanges <= 0) {
+        fprintf(stderr, "Usage: %s [events per scenario] [focus changes]\n", argv[0]);
+        return 2;
+    }
+
+    // The listener registrations resolve these types by name
+    g_type_ensure(ATK_TYPE_OBJECT);
+    g_type_ensure(ATK_TYPE_TABLE);
+    g_type_ensure(ATK_TYPE_TABLE_CELL);
+    g_type_ensure(ATK_TYPE_TEXT);
+    g_type_ensure(ATK_TYPE_DOCUMENT);
+    g_type_ensure(ATK_TYPE_WINDOW);
+    g_type_ensure(ATK_TYPE_COMPONENT);
+    g_type_ensure(ATK_TYPE_SELECTION);
+    g_type_ensure(ATK_TYPE_HYPERTEXT);
+
+    Tree tree;
+    buildTree(tree);
+
+    Scenario scenarios[] = {
+        { "focus (button)",        "StateEventListener",           emitFocus },
+        { "focus (table cell)",    "StateEventListener",           emitCellFocus },
+        { "state-change:checked",  "StateEventListener",           emitChecked },
+        { "state-change:showing",  "StateEventListener",           emitShowing },
+        { "property-change:name",  "PropertyEventListener",        emitNameChange },
+        { "children-changed:add",  "ChildrenChangedEventListener", emitChildAdded },
+        { "row-inserted",          "GenericEventListener",         emitRowInserted },
+        { "text typing",           "Text*EventListener",           emitTextInsert },
+    };
+    const size_t count = G_N_ELEMENTS(scenarios);
+
+    for(size_t i = 0; i < count; i++)
+        runScenario(tree, scenarios[i], events, scenarios[i].baselineNs, scenarios[i].baselineAllocs);
+
+    TTSStub::setSpeakObserver(SpeakObserved, NULL);
+    RDK_AT::Initialize();
+    RDK_AT::EnableProcessing(true);
+
+    uint64_t deadline = nowNs() + 5000000000ULL;
+    while(!TTSStub::sessionActive() && nowNs() < deadline)
+        pump(10);
+    pump(50);
+    if(!TTSStub::sessionActive())
+        fprintf(stderr, "warning: no TTS session, speech paths are not exercised\n");
+
+    for(size_t i = 0; i < count; i++)
+        runScenario(tree, scenarios[i], events, scenarios[i].ns, scenarios[i].allocs);
+
+    uint64_t spokenBefore = TTSStub::spokenCount();
+    std::vector<double> latencies;
+    unsigned timeouts = 0;
+    for(int i = 0; i < focusChanges; i++) {
+        AtkObject *target = tree.buttons[i % tree.buttons.size()];
+        {
+            std::lock_guard<std::mutex> lock(gSpeakMutex);
+            gExpected = atk_object_get_name(target);
+            gSpokenAt = 0;
+        }
+
+        uint64_t start = nowNs();
+        emitFocus(tree, i);
+        while(!gSpokenAt && nowNs() - start < 2000000000ULL) {
+            while(g_main_context_iteration(NULL, FALSE)) { }
+            g_usleep(100);
+        }
+
+        if(gSpokenAt)
+            latencies.push_back((gSpokenAt - start) / 1e6);
+        else
+            timeouts++;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    bool echoed = checkDoubledLetter(tree, tree.buttons[(focusChanges - 1) % tree.buttons.size()]);
+
+    printf("\n%-24s %-30s %12s %12s %12s %12s\n", "scenario", "listener", "events/s", "ns/event", "rdkat ns", "rdkat allocs");
+    for(size_t i = 0; i < count; i++) {
+        const Scenario &s = scenarios[i];
+        printf("%-24s %-30s %12.0f %12.0f %12.0f %12.2f\n", s.name, s.listener,
+            s.ns > 0 ? 1e9 / s.ns : 0, s.ns, s.ns - s.baselineNs, s.allocs - s.baselineAllocs);
+    }
+
+    printf("\nfocus-to-speak latency over %zu focus changes (%u timeouts, %llu utterances):\n",
+        latencies.size(), timeouts, (unsigned long long)(TTSStub::spokenCount() - spokenBefore));
+    printf("  p50 %.2f ms  p90 %.2f ms  p99 %.2f ms  max %.2f ms\n",
+        percentile(latencies, 0.5), percentile(latencies, 0.9), percentile(latencies, 0.99),
+        latencies.empty() ? 0.0 : latencies.back());
+    printf("\ntyping echo of a doubled letter: %s\n", echoed ? "ok" : "FAILED");
+
+    RDK_AT::Uninitialize();
+    return echoed ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "TTSClient.h"
+#include "tts_stub.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+int envInt(const char *name, int defaultValue)
+{
+    const char *value = getenv(name);
+    return value ? atoi(value) : defaultValue;
+}
+
+std::mutex gObserverMutex;
+TTSStub::SpeakObserver gObserver = NULL;
+void *gObserverData = NULL;
+
+std::atomic<bool> gSessionActive(false);
+std::atomic<uint64_t> gSpoken(0);
+std::atomic<uint64_t> gAborted(0);
+
+/**
+ * Simulates TTSManager: callbacks are delivered from a thread of its own,
+ * after the configured delays, like the real client's IPC thread does.
+ */
+class StubTTSClient : public TTS::TTSClient {
+public:
+    explicit StubTTSClient(TTS::TTSConnectionCallback *callback) :
+        m_connectionCallback(callback),
+        m_sessionCallback(NULL),
+        m_appId(0),
+        m_sessionId(0),
+        m_nextSessionId(1),
+        m_currentSpeech(0),
+        m_sequence(0),
+        m_quit(false),
+        m_callUs(envInt("RDKAT_BENCH_TTS_CALL_US", 200)),
+        m_startMs(envInt("RDKAT_BENCH_TTS_START_MS", 5)),
+        m_durationMs(envInt("RDKAT_BENCH_TTS_DURATION_MS", 50)),
+        m_enabled(envInt("RDKAT_BENCH_TTS_ENABLED", 1) != 0)
+    {
+        schedule(envInt("RDKAT_BENCH_TTS_CONNECT_MS", 10) * 1000, EV_CONNECTED, 0);
+        m_thread = std::thread(&StubTTSClient::run, this);
+    }
+
+    ~StubTTSClient()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_cond.notify_one();
+        m_thread.join();
+    }
+
+    bool isTTSEnabled(bool) override
+    {
+        call();
+        return m_enabled;
+    }
+
+    uint32_t createSession(uint32_t appId, std::string, TTS::TTSSessionCallback *callback) override
+    {
+        call();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_appId = appId;
+        m_sessionId = m_nextSessionId++;
+        m_sessionCallback = callback;
+        gSessionActive = true;
+        return m_sessionId;
+    }
+
+    bool isActiveSession(uint32_t sessionId, bool) override
+    {
+        call();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return sessionId && sessionId == m_sessionId;
+    }
+
+    TTS::TTS_Error speak(uint32_t sessionId, TTS::SpeechData &data) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(gObserverMutex);
+            if(gObserver)
+                gObserver(data.text, gObserverData);
+        }
+
+        call();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(sessionId != m_sessionId)
+            return TTS::TTS_INVALID_SESSION;
+
+        // A new utterance interrupts the current one, like TTSManager does
+        interruptLocked();
+        m_currentSpeech = data.id;
+        m_currentText = data.text;
+        gSpoken++;
+        scheduleLocked(m_startMs * 1000, EV_SPEECH_START, data.id);
+        return TTS::TTS_OK;
+    }
+
+    TTS::TTS_Error abort(uint32_t sessionId) override
+    {
+        call();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(sessionId != m_sessionId)
+            return TTS::TTS_INVALID_SESSION;
+        interruptLocked();
+        return TTS::TTS_OK;
+    }
+
+    TTS::TTS_Error destroySession(uint32_t sessionId) override
+    {
+        call();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(sessionId != m_sessionId)
+            return TTS::TTS_INVALID_SESSION;
+        m_events.clear();
+        m_sessionId = 0;
+        m_sessionCallback = NULL;
+        gSessionActive = false;
+        return TTS::TTS_OK;
+    }
+
+private:
+    enum EventType {
+        EV_CONNECTED,
+        EV_SPEECH_START,
+        EV_SPEECH_COMPLETE,
+        EV_SPEECH_INTERRUPTED
+    };
+
+    struct Event {
+        EventType type;
+        uint32_t speechId;
+    };
+
+    typedef std::pair<Clock::time_point, uint64_t> EventKey;
+
+    void call()
+    {
+        if(m_callUs > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(m_callUs));
+    }
+
+    void schedule(int delayUs, EventType type, uint32_t speechId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        scheduleLocked(delayUs, type, speechId);
+    }
+
+    void scheduleLocked(int delayUs, EventType type, uint32_t speechId)
+    {
+        Event ev = { type, speechId };
+        m_events[EventKey(Clock::now() + std::chrono::microseconds(delayUs), m_sequence++)] = ev;
+        m_cond.notify_one();
+    }
+
+    void interruptLocked()
+    {
+        if(!m_currentSpeech)
+            return;
+
+        for(auto it = m_events.begin(); it != m_events.end();) {
+            if(it->second.speechId == m_currentSpeech)
+                it = m_events.erase(it);
+            else
+                ++it;
+        }
+        scheduleLocked(0, EV_SPEECH_INTERRUPTED, m_currentSpeech);
+        m_currentSpeech = 0;
+        gAborted++;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(!m_quit) {
+            if(m_events.empty()) {
+                m_cond.wait(lock);
+                continue;
+            }
+
+            auto it = m_events.begin();
+            if(Clock::now() < it->first.first) {
+                m_cond.wait_until(lock, it->first.first);
+                continue;
+            }
+
+            Event ev = it->second;
+            m_events.erase(it);
+
+            TTS::TTSSessionCallback *session = m_sessionCallback;
+            uint32_t appId = m_appId, sessionId = m_sessionId;
+            TTS::SpeechData data;
+            data.id = ev.speechId;
+            data.text = m_currentText;
+
+            if(ev.type == EV_SPEECH_START)
+                scheduleLocked(m_durationMs * 1000, EV_SPEECH_COMPLETE, ev.speechId);
+            else if(ev.type == EV_SPEECH_COMPLETE && m_currentSpeech == ev.speechId)
+                m_currentSpeech = 0;
+
+            // Callbacks may call back into the client
+            lock.unlock();
+            switch(ev.type) {
+            case EV_CONNECTED:
+                m_connectionCallback->onTTSServerConnected();
+                m_connectionCallback->onTTSStateChanged(m_enabled);
+                break;
+            case EV_SPEECH_START:
+                if(session)
+                    session->onSpeechStart(appId, sessionId, data);
+                break;
+            case EV_SPEECH_COMPLETE:
+                if(session)
+                    session->onSpeechComplete(appId, sessionId, data);
+                break;
+            case EV_SPEECH_INTERRUPTED:
+                if(session)
+                    session->onSpeechInterrupted(appId, sessionId, ev.speechId);
+                break;
+            }
+            lock.lock();
+        }
+    }
+
+    TTS::TTSConnectionCallback *m_connectionCallback;
+    TTS::TTSSessionCallback *m_sessionCallback;
+    uint32_t m_appId;
+    uint32_t m_sessionId;
+    uint32_t m_nextSessionId;
+    uint32_t m_currentSpeech;
+    std::string m_currentText;
+
+    std::map<EventKey, Event> m_events;
+    uint64_t m_sequence;
+    bool m_quit;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::thread m_thread;
+
+    const int m_callUs;
+    const int m_startMs;
+    const int m_durationMs;
+    const bool m_enabled;
+};
+
+} // namespace
+
+namespace TTS {
+
+TTSClient *TTSClient::create(TTSConnectionCallback *connectionCallback, bool)
+{
+    return new StubTTSClient(connectionCallback);
+}
+
+} // namespace TTS
+
+namespace TTSStub {
+
+void setSpeakObserver(SpeakObserver observer, void *data)
+{
+    std::lock_guard<std::mutex> lock(gObserverMutex);
+    gObserver = observer;
+    gObserverData = data;
+}
+
+bool sessionActive()
+{
+    return gSessionActive;
+}
+
+uint64_t spokenCount()
+{
+    return gSpoken;
+}
+
+uint64_t abortedCount()
+{
+    return gAborted;
+}
+
+} // namespace TTSStub
@@ -0,0 +1,48 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_BENCH_TTS_STUB_H
+#define RDK_AT_BENCH_TTS_STUB_H
+
+#include <stdint.h>
+
+#include <string>
+
+/**
+ * Controls of the in process TTSManager simulation (tts_client_stub.cpp).
+ *
+ * Latencies are read from the environment when the client is created:
+ *   RDKAT_BENCH_TTS_CONNECT_MS   delay before onTTSServerConnected (default 10)
+ *   RDKAT_BENCH_TTS_CALL_US      time every client call blocks, i.e. IPC round trip (default 200)
+ *   RDKAT_BENCH_TTS_START_MS     delay between speak() and onSpeechStart (default 5)
+ *   RDKAT_BENCH_TTS_DURATION_MS  delay between onSpeechStart and onSpeechComplete (default 50)
+ *   RDKAT_BENCH_TTS_ENABLED      TTS state reported on connection (default 1)
+ */
+namespace TTSStub {
+
+// Invoked on the calling thread each time the client's speak() is called
+typedef void (*SpeakObserver)(const std::string &text, void *data);
+void setSpeakObserver(SpeakObserver observer, void *data);
+
+bool sessionActive();
+uint64_t spokenCount();
+uint64_t abortedCount();
+
+} // namespace TTSStub
+
+#endif // RDK_AT_BENCH_TTS_STUB_H
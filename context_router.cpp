@@ -0,0 +1,125 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "context_router.h"
+#include "view_context.h"
+#include "logger.h"
+
+#include <algorithm>
+
+namespace RDK_AT
+{
+
+ContextRouter::ContextRouter(ViewContext *defaultContext) :
+    m_default(defaultContext),
+    m_windows(g_hash_table_new(g_direct_hash, g_direct_equal)),
+    m_hits(0),
+    m_misses(0)
+{
+}
+
+ContextRouter::~ContextRouter()
+{
+    clear();
+    g_hash_table_destroy(m_windows);
+}
+
+void ContextRouter::add(ViewContext *context)
+{
+    m_contexts.push_back(context);
+    clear();
+}
+
+void ContextRouter::remove(ViewContext *context)
+{
+    m_contexts.erase(std::remove(m_contexts.begin(), m_contexts.end(), context), m_contexts.end());
+    clear();
+}
+
+bool ContextRouter::isWindow(AtkObject *obj)
+{
+    switch(atk_object_get_role(obj)) {
+    case ATK_ROLE_WINDOW:
+    case ATK_ROLE_FRAME:
+    case ATK_ROLE_DIALOG:
+    case ATK_ROLE_DOCUMENT_FRAME:
+    case ATK_ROLE_DOCUMENT_WEB:
+    case ATK_ROLE_EMBEDDED:
+        return true;
+    default:
+        return false;
+    }
+}
+
+ViewContext* ContextRouter::rootContext(AtkObject *obj) const
+{
+    for(size_t i = 0; i < m_contexts.size(); i++) {
+        if(m_contexts[i]->root() == obj)
+            return m_contexts[i];
+    }
+    return NULL;
+}
+
+ViewContext* ContextRouter::route(AtkObject *obj)
+{
+    // Single view, nothing to look up
+    if(m_contexts.empty() || !obj)
+        return m_default;
+
+    ViewContext *context = NULL;
+    AtkObject *window = NULL;
+    for(AtkObject *o = obj; o && !context; o = atk_object_get_parent(o)) {
+        context = static_cast<ViewContext*>(g_hash_table_lookup(m_windows, o));
+        if(context) {
+            m_hits++;
+            return context;
+        }
+        context = rootContext(o);
+        if(!window && isWindow(o))
+            window = o;
+    }
+    m_misses++;
+    if(!context)
+        context = m_default;
+
+    // A window above the root may hold several views, it is never cached as the walk stops at the root
+    if(window) {
+        g_object_weak_ref(G_OBJECT(window), WindowFinalized, this);
+        g_hash_table_insert(m_windows, window, context);
+    }
+    return context;
+}
+
+void ContextRouter::WindowFinalized(gpointer data, GObject *window)
+{
+    ContextRouter *self = static_cast<ContextRouter*>(data);
+    g_hash_table_remove(self->m_windows, window);
+}
+
+void ContextRouter::clear()
+{
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, m_windows);
+    while(g_hash_table_iter_next(&iter, &key, NULL))
+        g_object_weak_unref(G_OBJECT(key), WindowFinalized, this);
+    g_hash_table_remove_all(m_windows);
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,76 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_CONTEXT_ROUTER_H
+#define RDK_AT_CONTEXT_ROUTER_H
+
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+
+#include <vector>
+
+namespace RDK_AT
+{
+
+class ViewContext;
+
+/**
+ * @brief Finds the view context an accessible belongs to.
+ *
+ * The parent chain is walked up to the nearest context root. The result is
+ * cached per window, i.e. per nearest window or document ancestor below the
+ * root, so that only the first event from a window walks up the tree.
+ * Entries are held through GObject weak references and are all dropped
+ * when a context is added or removed.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class ContextRouter {
+public:
+    explicit ContextRouter(ViewContext *defaultContext);
+    ~ContextRouter();
+
+    void add(ViewContext *context);
+    void remove(ViewContext *context);
+    ViewContext* route(AtkObject *obj);
+    void clear();
+
+    const std::vector<ViewContext*>& contexts() const { return m_contexts; }
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+private:
+    ContextRouter(const ContextRouter &);
+    ContextRouter& operator=(const ContextRouter &);
+
+    ViewContext* rootContext(AtkObject *obj) const;
+    static bool isWindow(AtkObject *obj);
+    static void WindowFinalized(gpointer data, GObject *window);
+
+    ViewContext *m_default;
+    std::vector<ViewContext*> m_contexts; // w/ a root, innermost roots win
+    GHashTable *m_windows; // AtkObject* -> ViewContext*
+    StatCounter m_hits;
+    StatCounter m_misses;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_CONTEXT_ROUTER_H
@@ -0,0 +1,187 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "ducking_controller.h"
+#include "logger.h"
+
+#include <stdlib.h>
+
+namespace RDK_AT
+{
+
+static const float kDefaultDuckLevel = 0.25;
+static const guint kDefaultHoldMs = 300;
+static const guint kDefaultRampMs = 40;
+
+GSourceFuncs DuckingController::s_sourceFuncs = {
+    NULL,
+    NULL,
+    DuckingController::Dispatch,
+    NULL
+};
+
+DuckingController::DuckingController() :
+    m_source(NULL),
+    m_cb(NULL),
+    m_cbData(NULL),
+    m_state(STATE_RELEASED),
+    m_volume(1),
+    m_level(kDefaultDuckLevel),
+    m_holdMs(kDefaultHoldMs),
+    m_rampSteps(0),
+    m_rampMs(kDefaultRampMs),
+    m_callbacks(0),
+    m_ducks(0),
+    m_releases(0)
+{
+    const char *value = getenv("RDKAT_DUCK_LEVEL");
+    if(value && atof(value) >= 0 && atof(value) <= 1)
+        m_level = atof(value);
+
+    value = getenv("RDKAT_DUCK_HOLD_MS");
+    if(value)
+        m_holdMs = atoi(value);
+
+    value = getenv("RDKAT_DUCK_RAMP_STEPS");
+    if(value)
+        m_rampSteps = atoi(value);
+
+    value = getenv("RDKAT_DUCK_RAMP_MS");
+    if(value && atoi(value) > 0)
+        m_rampMs = atoi(value);
+}
+
+DuckingController::~DuckingController()
+{
+    stop();
+}
+
+void DuckingController::start(GMainContext *context)
+{
+    if(m_source)
+        return;
+
+    m_source = g_source_new(&s_sourceFuncs, sizeof(TimerSource));
+    reinterpret_cast<TimerSource*>(m_source)->controller = this;
+    g_source_set_name(m_source, "rdkat-ducking");
+    g_source_set_ready_time(m_source, -1);
+    g_source_attach(m_source, context);
+}
+
+void DuckingController::stop()
+{
+    if(m_source) {
+        g_source_destroy(m_source);
+        g_source_unref(m_source);
+        m_source = NULL;
+    }
+}
+
+void DuckingController::setCallback(MediaVolumeControlCallback cb, void *data)
+{
+    m_cb = cb;
+    m_cbData = data;
+}
+
+void DuckingController::apply(float volume)
+{
+    if(volume == m_volume)
+        return;
+
+    m_volume = volume;
+    if(m_cb) {
+        m_cb(m_cbData, volume);
+        m_callbacks++;
+    }
+}
+
+void DuckingController::arm(guint ms)
+{
+    if(m_source)
+        g_source_set_ready_time(m_source, ms ? g_get_monotonic_time() + ms * 1000 : 0);
+}
+
+void DuckingController::duck()
+{
+    if(m_state == STATE_DUCKED)
+        return;
+
+    if(m_state != STATE_HOLDING)
+        m_ducks++;
+    if(m_source)
+        g_source_set_ready_time(m_source, -1);
+    apply(m_level);
+    m_state = STATE_DUCKED;
+}
+
+void DuckingController::idle()
+{
+    if(m_state != STATE_DUCKED)
+        return;
+
+    // W/o a timer there is nothing to wait with
+    if(!m_source) {
+        release();
+        return;
+    }
+
+    m_state = STATE_HOLDING;
+    arm(m_holdMs);
+}
+
+void DuckingController::release()
+{
+    if(m_source)
+        g_source_set_ready_time(m_source, -1);
+    if(m_state != STATE_RELEASED)
+        m_releases++;
+    apply(1);
+    m_state = STATE_RELEASED;
+}
+
+void DuckingController::timeout()
+{
+    if(m_state == STATE_HOLDING) {
+        if(m_rampSteps < 2) {
+            release();
+            return;
+        }
+        m_state = STATE_RAMPING;
+    }
+
+    if(m_state != STATE_RAMPING)
+        return;
+
+    float volume = m_volume + (1 - m_level) / m_rampSteps;
+    if(volume >= 0.999f) {
+        release();
+        return;
+    }
+    apply(volume);
+    arm(m_rampMs);
+}
+
+gboolean DuckingController::Dispatch(GSource *source, GSourceFunc, gpointer)
+{
+    g_source_set_ready_time(source, -1);
+    reinterpret_cast<TimerSource*>(source)->controller->timeout();
+    return G_SOURCE_CONTINUE;
+}
+
+} // namespace RDK_AT
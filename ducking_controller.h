@@ -0,0 +1,99 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_DUCKING_CONTROLLER_H
+#define RDK_AT_DUCKING_CONTROLLER_H
+
+#include "rdkat.h"
+#include "statistics.h"
+
+#include <glib.h>
+#include <stdint.h>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Lowers the media volume while speech is queued or being spoken.
+ *
+ * Media stays ducked across back to back utterances and is only restored
+ * once speech has been idle for a hold time (RDKAT_DUCK_HOLD_MS, default
+ * 300), either at once or in RDKAT_DUCK_RAMP_STEPS steps (default 0) of
+ * RDKAT_DUCK_RAMP_MS (default 40). The ducked level is RDKAT_DUCK_LEVEL
+ * (default 0.25). The volume callback is only invoked on actual changes.
+ *
+ * Only to be used from the speech dispatcher thread, counters excepted.
+ */
+class DuckingController {
+public:
+    DuckingController();
+    ~DuckingController();
+
+    void start(GMainContext *context);
+    void stop();
+
+    void setCallback(MediaVolumeControlCallback cb, void *data);
+
+    void duck();     // speech is about to be spoken
+    void idle();     // nothing is queued or being spoken, restore after the hold time
+    void release();  // restore now, e.g. the session went away
+
+    bool ducked() const { return m_state != STATE_RELEASED; }
+    uint64_t callbackCount() const { return m_callbacks; }
+    uint64_t duckCount() const { return m_ducks; }
+    uint64_t releaseCount() const { return m_releases; }
+
+private:
+    DuckingController(const DuckingController &);
+    DuckingController& operator=(const DuckingController &);
+
+    enum State {
+        STATE_RELEASED,
+        STATE_DUCKED,
+        STATE_HOLDING,
+        STATE_RAMPING
+    };
+
+    void apply(float volume);
+    void arm(guint ms);
+    void timeout();
+    static gboolean Dispatch(GSource *source, GSourceFunc, gpointer);
+    static GSourceFuncs s_sourceFuncs;
+
+    struct TimerSource {
+        GSource source;
+        DuckingController *controller;
+    };
+
+    GSource *m_source;
+    MediaVolumeControlCallback m_cb;
+    void *m_cbData;
+    State m_state;
+    float m_volume;
+    float m_level;
+    guint m_holdMs;
+    guint m_rampSteps;
+    guint m_rampMs;
+    StatCounter m_callbacks;
+    StatCounter m_ducks;
+    StatCounter m_releases;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_DUCKING_CONTROLLER_H
@@ -0,0 +1,243 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "event_filter.h"
+#include "event_record.h"
+#include "logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+
+static_assert(RDK_AT::EVENT_MINOR_COUNT <= 32, "EventFilter keeps minors in a 32 bits mask");
+
+namespace RDK_AT
+{
+
+static const char kDefaultFilterFile[] = "/etc/rdkat/event_filter.conf";
+static const uint32_t kAllMinors = (uint32_t)((1ull << EVENT_MINOR_COUNT) - 1);
+
+// Indexed by EventClass
+static const char* const kClassKeys[] = { "object", "window", "document", "focus" };
+
+static EventClass majorClass(EventMajor major)
+{
+    switch(major) {
+    case EVENT_MAJOR_FOCUS:
+        return EVENT_CLASS_FOCUS;
+    case EVENT_MAJOR_WINDOW_CREATE:
+    case EVENT_MAJOR_WINDOW_DESTROY:
+    case EVENT_MAJOR_WINDOW_MINIMIZE:
+    case EVENT_MAJOR_WINDOW_MAXIMIZE:
+    case EVENT_MAJOR_WINDOW_RESTORE:
+    case EVENT_MAJOR_WINDOW_ACTIVATE:
+    case EVENT_MAJOR_WINDOW_DEACTIVATE:
+        return EVENT_CLASS_WINDOW;
+    case EVENT_MAJOR_LOAD_COMPLETE:
+    case EVENT_MAJOR_RELOAD:
+    case EVENT_MAJOR_LOAD_STOPPED:
+        return EVENT_CLASS_DOCUMENT;
+    default:
+        return EVENT_CLASS_OBJECT;
+    }
+}
+
+static std::string trim(const std::string &s)
+{
+    size_t begin = s.find_first_not_of(" \t\r");
+    if(begin == std::string::npos)
+        return std::string();
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+EventFilter::EventFilter() :
+    m_filterRoles(false)
+{
+    for(int i = 0; i < EVENT_MAJOR_COUNT; i++) {
+        m_minors[i] = kAllMinors;
+        m_kept[i] = 0;
+    }
+}
+
+void EventFilter::load()
+{
+    for(int i = 0; i < EVENT_MAJOR_COUNT; i++)
+        m_minors[i] = kAllMinors;
+    m_roles.reset();
+    m_filterRoles = false;
+
+    std::string policy;
+    const char *source = "RDKAT_EVENT_FILTER";
+    const char *inlinePolicy = getenv("RDKAT_EVENT_FILTER");
+    if(inlinePolicy) {
+        policy = inlinePolicy;
+    } else {
+        source = getenv("RDKAT_EVENT_FILTER_FILE");
+        if(!source || !*source)
+            source = kDefaultFilterFile;
+
+        std::ifstream file(source);
+        if(!file)
+            return;
+        std::stringstream content;
+        content << file.rdbuf();
+        policy = content.str();
+    }
+
+    if(!parse(policy)) {
+        RDKLOG_ERROR("Invalid event filter in %s, keeping every event", source);
+        for(int i = 0; i < EVENT_MAJOR_COUNT; i++)
+            m_minors[i] = kAllMinors;
+        m_filterRoles = false;
+        return;
+    }
+
+    int majors = 0;
+    for(int i = EVENT_MAJOR_FOCUS; i < EVENT_MAJOR_COUNT; i++) {
+        if(m_minors[i])
+            majors++;
+    }
+    RDKLOG_INFO("Event filter from %s keeps %d of %d event types%s", source,
+        majors, EVENT_MAJOR_COUNT - 1, m_filterRoles ? ", filtered by role" : "");
+}
+
+bool EventFilter::parse(const std::string &policy)
+{
+    // classes / events select, ignore then removes, whatever the order of statements
+    std::string classes, events, ignore, roles;
+    bool hasClasses = false, hasEvents = false;
+
+    std::string line;
+    std::istringstream in(policy);
+    while(std::getline(in, line)) {
+        std::istringstream statements(line.substr(0, line.find('#')));
+        std::string s;
+        while(std::getline(statements, s, ';')) {
+            s = trim(s);
+            if(s.empty())
+                continue;
+
+            size_t eq = s.find('=');
+            if(eq == std::string::npos) {
+                RDKLOG_ERROR("Event filter statement w/o '=': \"%s\"", s.c_str());
+                return false;
+            }
+            std::string key = trim(s.substr(0, eq));
+            std::string values = s.substr(eq + 1);
+            if(key == "classes") {
+                classes += "," + values;
+                hasClasses = true;
+            } else if(key == "events") {
+                events += "," + values;
+                hasEvents = true;
+            } else if(key == "ignore") {
+                ignore += "," + values;
+            } else if(key == "roles") {
+                roles += "," + values;
+                m_filterRoles = true;
+            } else {
+                RDKLOG_ERROR("Unknown event filter key \"%s\"", key.c_str());
+                return false;
+            }
+        }
+    }
+
+    if(hasClasses || hasEvents) {
+        for(int i = 0; i < EVENT_MAJOR_COUNT; i++)
+            m_minors[i] = 0;
+    }
+
+    return statement("classes", classes) && statement("events", events) &&
+        statement("ignore", ignore) && statement("roles", roles);
+}
+
+bool EventFilter::statement(const std::string &key, const std::string &values)
+{
+    std::istringstream in(values);
+    std::string value;
+    while(std::getline(in, value, ',')) {
+        value = trim(value);
+        if(value.empty())
+            continue;
+
+        if(key == "classes") {
+            int klass = -1;
+            for(int c = 0; c < (int)G_N_ELEMENTS(kClassKeys); c++) {
+                if(value == kClassKeys[c])
+                    klass = c;
+            }
+            if(klass < 0) {
+                RDKLOG_ERROR("Unknown event class \"%s\"", value.c_str());
+                return false;
+            }
+            for(int i = EVENT_MAJOR_FOCUS; i < EVENT_MAJOR_COUNT; i++) {
+                if(majorClass((EventMajor)i) == klass)
+                    m_minors[i] = kAllMinors;
+            }
+        } else if(key == "events" || key == "ignore") {
+            if(!setEvent(value, key == "events"))
+                return false;
+        } else if(key == "roles") {
+            AtkRole role = atk_role_for_name(value.c_str());
+            if(role <= ATK_ROLE_INVALID || role >= ATK_ROLE_LAST_DEFINED) {
+                RDKLOG_ERROR("Unknown role \"%s\"", value.c_str());
+                return false;
+            }
+            m_roles.set(role);
+        }
+    }
+    return true;
+}
+
+bool EventFilter::setEvent(const std::string &spec, bool keep)
+{
+    size_t colon = spec.find(':');
+    std::string majorName = spec.substr(0, colon);
+    EventMajor major = eventMajorFromName(majorName.c_str());
+    if(major == EVENT_MAJOR_UNKNOWN) {
+        RDKLOG_ERROR("Unknown event \"%s\"", majorName.c_str());
+        return false;
+    }
+
+    uint32_t bits = kAllMinors;
+    if(colon != std::string::npos) {
+        std::string minorName = spec.substr(colon + 1);
+        int minor = -1;
+        for(int i = EVENT_MINOR_OTHER; i < EVENT_MINOR_COUNT; i++) {
+            if(minorName == eventMinorName((EventMinor)i))
+                minor = i;
+        }
+        if(minor < 0) {
+            RDKLOG_ERROR("Unknown event detail \"%s\"", minorName.c_str());
+            return false;
+        }
+        bits = 1u << minor;
+    }
+
+    if(keep)
+        m_minors[major] |= bits;
+    else
+        m_minors[major] &= ~bits;
+    return true;
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,85 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_EVENT_FILTER_H
+#define RDK_AT_EVENT_FILTER_H
+
+#include "event_types.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stdint.h>
+
+#include <bitset>
+#include <string>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Which events are worth handling, compiled into bitsets.
+ *
+ * The policy is read by load() from RDKAT_EVENT_FILTER, or else from the
+ * file named by RDKAT_EVENT_FILTER_FILE (default /etc/rdkat/event_filter.conf).
+ * It is made of "key=value,value" statements, separated by ';' or new
+ * lines, '#' starts a comment:
+ *   classes=object,window,document,focus   event classes to keep
+ *   events=state-changed:focused,load-complete   majors, or major:minor, to keep
+ *   ignore=bounds-changed,text-changed:insert    majors, or major:minor, to drop
+ *   roles=push button,check box               roles, by ATK name, to keep
+ * Without a policy every event is kept.
+ *
+ * Events registered with keep() invalidate cached utterances and table
+ * context (name, description and role changes, checked/pressed/expanded/
+ * selected, table and children changes). The policy can't drop them, or
+ * stale text would be spoken: passes() always lets them through and their
+ * listeners stay attached, accepts() tells whether they may also be spoken.
+ *
+ * Only to be used from the thread which emits ATK signals once loaded.
+ */
+class EventFilter {
+public:
+    EventFilter();
+
+    void load();
+
+    bool accepts(EventMajor major, EventMinor minor) const { return (m_minors[major] >> minor) & 1; }
+    bool acceptsMajor(EventMajor major) const { return m_minors[major] != 0; }
+    bool filtersRoles() const { return m_filterRoles; }
+    bool acceptsRole(AtkRole role) const { return role >= 0 && role < ATK_ROLE_LAST_DEFINED && m_roles[role]; }
+
+    // Whatever the policy, major:minor reaches the handlers
+    void keep(EventMajor major, EventMinor minor) { m_kept[major] |= 1u << minor; }
+    bool kept(EventMajor major, EventMinor minor) const { return (m_kept[major] >> minor) & 1; }
+    bool passes(EventMajor major, EventMinor minor) const { return ((m_minors[major] | m_kept[major]) >> minor) & 1; }
+    bool passesMajor(EventMajor major) const { return (m_minors[major] | m_kept[major]) != 0; }
+
+private:
+    bool parse(const std::string &policy);
+    bool statement(const std::string &key, const std::string &values);
+    bool setEvent(const std::string &spec, bool keep);
+
+    uint32_t m_minors[EVENT_MAJOR_COUNT]; // bit per EventMinor
+    uint32_t m_kept[EVENT_MAJOR_COUNT];
+    std::bitset<ATK_ROLE_LAST_DEFINED> m_roles;
+    bool m_filterRoles;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_EVENT_FILTER_H
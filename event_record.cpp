@@ -0,0 +1,69 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "event_record.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace RDK_AT
+{
+
+static const char* const kClassNames[] = {
+    "rdkat.Event.Object",
+    "rdkat.Event.Window",
+    "rdkat.Event.Document",
+    "rdkat.Event.Focus"
+};
+
+const char* eventClassName(EventClass klass)
+{
+    return klass < G_N_ELEMENTS(kClassNames) ? kClassNames[klass] : "";
+}
+
+char* EventArena::alloc(size_t size)
+{
+    if(size > available())
+        return NULL;
+
+    char *p = m_buffer + m_used;
+    m_used += size;
+    return p;
+}
+
+const char* EventArena::printf(const char *format, ...)
+{
+    if(!available())
+        return "";
+
+    char *p = m_buffer + m_used;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(p, available(), format, args);
+    va_end(args);
+
+    if(n < 0) {
+        *p = '\0';
+        n = 0;
+    }
+    m_used += ((size_t)n < available() ? (size_t)n : available() - 1) + 1;
+    return p;
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,145 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_EVENT_RECORD_H
+#define RDK_AT_EVENT_RECORD_H
+
+#include "event_types.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+namespace RDK_AT
+{
+
+enum EventClass : uint8_t {
+    EVENT_CLASS_OBJECT,
+    EVENT_CLASS_WINDOW,
+    EVENT_CLASS_DOCUMENT,
+    EVENT_CLASS_FOCUS
+};
+
+enum EventValueType : uint8_t {
+    EVENT_VALUE_NONE,
+    EVENT_VALUE_INT,
+    EVENT_VALUE_STRING,
+    EVENT_VALUE_POINTER
+};
+
+const char* eventClassName(EventClass klass);
+
+/**
+ * @brief What a listener hands over to the dispatcher.
+ *
+ * Names are interned (signal names, quark strings or literals) and pointers
+ * are borrowed from the signal emission, so a record is only valid while
+ * the listener runs. Strings built while handling the event go into the
+ * EventArena.
+ */
+struct EventRecord {
+    AtkObject *object;
+    const gchar *majorName;
+    const gchar *minorName;   // signal detail / state / property name, may be NULL
+    const char *minorPrefix;  // printed as "<prefix>:<minorName>", may be NULL
+    const void *value;
+    gint32 d1;
+    gint32 d2;
+    EventMajor major;
+    EventMinor minor;
+    EventClass klass;
+    EventValueType valueType;
+};
+
+static_assert(std::is_trivially_copyable<EventRecord>::value, "EventRecord must stay trivially copyable");
+
+inline EventRecord makeEventRecord(AtkObject *object, EventClass klass, EventMajor major, EventMinor minor,
+        const gchar *majorName, const gchar *minorName)
+{
+    EventRecord event;
+    event.object = object;
+    event.majorName = majorName;
+    event.minorName = minorName;
+    event.minorPrefix = NULL;
+    event.value = NULL;
+    event.d1 = 0;
+    event.d2 = 0;
+    event.major = major;
+    event.minor = minor;
+    event.klass = klass;
+    event.valueType = EVENT_VALUE_NONE;
+    return event;
+}
+
+inline EventRecord withValue(EventRecord event, const void *value, EventValueType type)
+{
+    event.value = value;
+    event.valueType = type;
+    return event;
+}
+
+/**
+ * @brief Bump allocator for text produced while handling an event.
+ *
+ * Space is given back by rewinding to a mark taken before dispatch, which
+ * keeps nested emissions (e.g. a name computation emitting a signal) safe.
+ * When full, allocations fail instead of falling back to the heap.
+ */
+class EventArena {
+public:
+    EventArena() : m_used(0) { }
+
+    size_t mark() const { return m_used; }
+    void rewind(size_t mark) { m_used = mark; }
+
+    // Returns NULL when less than size bytes are left
+    char* alloc(size_t size);
+
+    // Formats into the arena, truncating to what is left; never returns NULL
+    const char* printf(const char *format, ...) G_GNUC_PRINTF(2, 3);
+
+    size_t available() const { return sizeof(m_buffer) - m_used; }
+
+private:
+    EventArena(const EventArena &);
+    EventArena& operator=(const EventArena &);
+
+    char m_buffer[4096];
+    size_t m_used;
+};
+
+// Gives back everything allocated from the arena during its lifetime
+class EventArenaScope {
+public:
+    explicit EventArenaScope(EventArena &arena) : m_arena(arena), m_mark(arena.mark()) { }
+    ~EventArenaScope() { m_arena.rewind(m_mark); }
+
+private:
+    EventArenaScope(const EventArenaScope &);
+    EventArenaScope& operator=(const EventArenaScope &);
+
+    EventArena &m_arena;
+    size_t m_mark;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_EVENT_RECORD_H
@@ -0,0 +1,285 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "event_trace.h"
+#include "logger.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace RDK_AT
+{
+
+static uint64_t clockNs(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+EventTrace::EventTrace() :
+    m_fd(-1),
+    m_buffer(NULL),
+    m_used(0),
+    m_records(0),
+    m_objects(NULL),
+    m_names(NULL),
+    m_values(NULL),
+    m_nextObjectId(0),
+    m_nextNameId(0),
+    m_nextValueId(0)
+{
+}
+
+EventTrace::~EventTrace()
+{
+    close();
+}
+
+bool EventTrace::open(const char *path)
+{
+    if(enabled())
+        return true;
+
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0) {
+        RDKLOG_ERROR("Unable to open trace file \"%s\", errno=%d", path, errno);
+        return false;
+    }
+
+    TraceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+    header.version = kTraceVersion;
+    header.recordSize = sizeof(TraceRecord);
+    header.startRealtimeNs = clockNs(CLOCK_REALTIME);
+    header.startMonotonicNs = clockNs(CLOCK_MONOTONIC);
+
+    if(write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+        RDKLOG_ERROR("Unable to write trace header to \"%s\", errno=%d", path, errno);
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_buffer = g_new(TraceRecord, kBufferRecords);
+    m_used = 0;
+    m_records = 0;
+    m_objects = g_hash_table_new(g_direct_hash, g_direct_equal);
+    m_names = g_hash_table_new(g_direct_hash, g_direct_equal);
+    m_values = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    m_nextObjectId = 0;
+    m_nextNameId = 0;
+    m_nextValueId = 0;
+
+    RDKLOG_INFO("Tracing ATK events to \"%s\"", path);
+    return true;
+}
+
+void EventTrace::close()
+{
+    if(!enabled())
+        return;
+
+    flush();
+    ::close(m_fd);
+    m_fd = -1;
+
+    RDKLOG_INFO("Event trace closed, records=%llu", (unsigned long long)m_records);
+
+    g_free(m_buffer);
+    m_buffer = NULL;
+    g_hash_table_destroy(m_objects);
+    g_hash_table_destroy(m_names);
+    g_hash_table_destroy(m_values);
+    m_objects = m_names = m_values = NULL;
+}
+
+void EventTrace::flush()
+{
+    const char *data = reinterpret_cast<const char*>(m_buffer);
+    size_t size = m_used * sizeof(TraceRecord);
+    while(size) {
+        ssize_t n = write(m_fd, data, size);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            RDKLOG_ERROR("Trace write failed, errno=%d, %zu records lost", errno, size / sizeof(TraceRecord));
+            break;
+        }
+        data += n;
+        size -= n;
+    }
+    m_used = 0;
+}
+
+TraceRecord* EventTrace::reserve(size_t count)
+{
+    if(m_used + count > kBufferRecords)
+        flush();
+
+    TraceRecord *record = m_buffer + m_used;
+    memset(record, 0, count * sizeof(TraceRecord));
+    m_used += count;
+    m_records += count;
+    return record;
+}
+
+void EventTrace::defineString(const gchar *str, uint32_t id, TraceStringTable table)
+{
+    size_t length = strlen(str);
+    size_t blocks = (length + sizeof(TraceRecord) - 1) / sizeof(TraceRecord);
+
+    // Very long strings are cut so that a definition always fits into the buffer
+    if(blocks >= kBufferRecords) {
+        blocks = kBufferRecords - 1;
+        length = blocks * sizeof(TraceRecord);
+    }
+
+    TraceRecord *record = reserve(1 + blocks);
+    record->timestampNs = clockNs(CLOCK_MONOTONIC);
+    record->kind = TRACE_RECORD_STRING;
+    record->object = kTraceNoId;
+    record->majorName = kTraceNoName;
+    record->minorName = kTraceNoName;
+    record->value = id;
+    record->d1 = (int32_t)length;
+    record->d2 = table;
+    memcpy(record + 1, str, length);
+}
+
+uint16_t EventTrace::nameId(const gchar *name)
+{
+    if(!name)
+        return kTraceNoName;
+
+    // Names are mostly interned already, this makes them comparable by address
+    const gchar *interned = g_intern_string(name);
+    gpointer value = g_hash_table_lookup(m_names, interned);
+    if(value)
+        return (uint16_t)(GPOINTER_TO_UINT(value) - 1);
+
+    if(m_nextNameId >= kTraceNoName)
+        return kTraceNoName;
+
+    uint16_t id = (uint16_t)m_nextNameId++;
+    g_hash_table_insert(m_names, (gpointer)interned, GUINT_TO_POINTER(id + 1));
+    defineString(interned, id, TRACE_STRINGS_NAMES);
+    return id;
+}
+
+uint32_t EventTrace::valueStringId(const gchar *str)
+{
+    if(!str)
+        return kTraceNoId;
+
+    gpointer value = g_hash_table_lookup(m_values, str);
+    if(value)
+        return GPOINTER_TO_UINT(value) - 1;
+
+    if(m_nextValueId >= kMaxValueStrings)
+        return kTraceNoId;
+
+    uint32_t id = m_nextValueId++;
+    g_hash_table_insert(m_values, g_strdup(str), GUINT_TO_POINTER(id + 1));
+    defineString(str, id, TRACE_STRINGS_VALUES);
+    return id;
+}
+
+uint32_t EventTrace::objectId(AtkObject *obj)
+{
+    if(!obj)
+        return kTraceNoId;
+
+    gpointer value = g_hash_table_lookup(m_objects, obj);
+    if(value)
+        return GPOINTER_TO_UINT(value) - 1;
+
+    uint32_t id = m_nextObjectId++;
+    g_hash_table_insert(m_objects, obj, GUINT_TO_POINTER(id + 1));
+
+    uint16_t role = nameId(atk_role_get_name(atk_object_get_role(obj)));
+    TraceRecord *record = reserve(1);
+    record->timestampNs = clockNs(CLOCK_MONOTONIC);
+    record->kind = TRACE_RECORD_OBJECT;
+    record->object = id;
+    record->majorName = kTraceNoName;
+    record->minorName = kTraceNoName;
+    record->value = role;
+    return id;
+}
+
+void EventTrace::event(const EventRecord &event)
+{
+    if(!enabled())
+        return;
+
+    // Definitions go first, so that the decoder always knows the ids it reads
+    uint32_t object = objectId(event.object);
+    uint16_t major = nameId(event.majorName);
+    uint16_t minor = nameId(event.minorName);
+
+    uint32_t value = 0;
+    switch(event.valueType) {
+    case EVENT_VALUE_INT:
+        value = (uint32_t)GPOINTER_TO_INT(event.value);
+        break;
+    case EVENT_VALUE_STRING:
+        value = valueStringId((const gchar*)event.value);
+        break;
+    case EVENT_VALUE_POINTER:
+        value = ATK_IS_OBJECT(event.value) ? objectId((AtkObject*)event.value) : kTraceNoId;
+        break;
+    default:
+        break;
+    }
+
+    TraceRecord *record = reserve(1);
+    record->timestampNs = clockNs(CLOCK_MONOTONIC);
+    record->kind = TRACE_RECORD_EVENT;
+    record->object = object;
+    record->majorName = major;
+    record->minorName = minor;
+    record->d1 = event.d1;
+    record->d2 = event.d2;
+    record->value = value;
+    record->major = event.major;
+    record->minor = event.minor;
+    record->klassAndValueType = (uint8_t)((event.klass << 4) | (event.valueType & 0x0F));
+}
+
+void EventTrace::speak(AtkObject *obj, size_t length)
+{
+    if(!enabled())
+        return;
+
+    uint32_t object = objectId(obj);
+    TraceRecord *record = reserve(1);
+    record->timestampNs = clockNs(CLOCK_MONOTONIC);
+    record->kind = TRACE_RECORD_SPEAK;
+    record->object = object;
+    record->majorName = kTraceNoName;
+    record->minorName = kTraceNoName;
+    record->d1 = (int32_t)length;
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,90 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_EVENT_TRACE_H
+#define RDK_AT_EVENT_TRACE_H
+
+#include "event_record.h"
+#include "event_trace_format.h"
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Optional binary trace of the ATK events received, see event_trace_format.h
+ *
+ * Records are appended to a preallocated buffer which is written out when
+ * full and on close. Nothing is done unless open() succeeded, which
+ * Initialize() does when RDKAT_TRACE_FILE names a file.
+ *
+ * Object ids are given per AtkObject address, so an address reused after
+ * finalization keeps its id. At most kMaxValueStrings distinct value strings
+ * are recorded, later ones are traced as kTraceNoId.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class EventTrace {
+public:
+    EventTrace();
+    ~EventTrace();
+
+    bool open(const char *path);
+    void close();
+    bool enabled() const { return m_fd >= 0; }
+
+    void event(const EventRecord &event);
+    void speak(AtkObject *obj, size_t length);
+
+    uint64_t recordCount() const { return m_records; }
+
+private:
+    EventTrace(const EventTrace &);
+    EventTrace& operator=(const EventTrace &);
+
+    static const size_t kBufferRecords = 2048;
+    static const guint kMaxValueStrings = 16384;
+
+    TraceRecord* reserve(size_t count);
+    void flush();
+    uint32_t objectId(AtkObject *obj);
+    uint16_t nameId(const gchar *name);
+    uint32_t valueStringId(const gchar *str);
+    void defineString(const gchar *str, uint32_t id, TraceStringTable table);
+
+    int m_fd;
+    TraceRecord *m_buffer;
+    size_t m_used;
+    StatCounter m_records;
+
+    GHashTable *m_objects;  // AtkObject* -> id + 1
+    GHashTable *m_names;    // interned name -> id + 1
+    GHashTable *m_values;   // owned copy -> id + 1
+    uint32_t m_nextObjectId;
+    uint32_t m_nextNameId;
+    uint32_t m_nextValueId;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_EVENT_TRACE_H
@@ -0,0 +1,84 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_EVENT_TRACE_FORMAT_H
+#define RDK_AT_EVENT_TRACE_FORMAT_H
+
+#include <stdint.h>
+
+/**
+ * On-disk layout of the binary event trace (RDKAT_TRACE_FILE).
+ * Shared with the decoder tool, hence no glib / atk dependency.
+ *
+ * A file is a TraceFileHeader followed by fixed size TraceRecords.
+ * Strings and objects are written once, as a definition record, the first
+ * time they are seen and are referred to by id afterwards. A string
+ * definition is followed by its bytes, padded to whole records.
+ * All integers are in host byte order.
+ */
+namespace RDK_AT
+{
+
+static const char kTraceMagic[8] = { 'R', 'D', 'K', 'A', 'T', 'T', 'R', 'C' };
+static const uint32_t kTraceVersion = 1;
+
+// Object / string id meaning "not recorded"
+static const uint32_t kTraceNoId = 0xFFFFFFFF;
+static const uint16_t kTraceNoName = 0xFFFF;
+
+enum TraceRecordKind : uint8_t {
+    TRACE_RECORD_EVENT = 1,  // an ATK event as received by a listener
+    TRACE_RECORD_STRING,     // value = string id, d1 = length, d2 = TraceStringTable, bytes follow
+    TRACE_RECORD_OBJECT,     // object = object id, value = name id of its role
+    TRACE_RECORD_SPEAK       // object spoken about, d1 = utterance length
+};
+
+// Names (signals, details, roles) and values (event data) are numbered separately
+enum TraceStringTable {
+    TRACE_STRINGS_NAMES = 0,
+    TRACE_STRINGS_VALUES = 1
+};
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t startRealtimeNs;   // CLOCK_REALTIME when the trace was opened
+    uint64_t startMonotonicNs;  // CLOCK_MONOTONIC at the same instant
+};
+
+struct TraceRecord {
+    uint64_t timestampNs;  // CLOCK_MONOTONIC
+    uint32_t object;       // object id, kTraceNoId when none
+    uint16_t majorName;    // name id
+    uint16_t minorName;    // name id, kTraceNoName when none
+    int32_t d1;
+    int32_t d2;
+    uint32_t value;        // int, string id or object id depending on valueType
+    uint8_t kind;          // TraceRecordKind
+    uint8_t major;         // EventMajor
+    uint8_t minor;         // EventMinor
+    uint8_t klassAndValueType; // EventClass << 4 | EventValueType
+};
+
+static_assert(sizeof(TraceFileHeader) == 32, "trace header layout changed");
+static_assert(sizeof(TraceRecord) == 32, "trace record layout changed");
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_EVENT_TRACE_FORMAT_H
@@ -0,0 +1,153 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "event_types.h"
+
+#include <string.h>
+
+#include <vector>
+
+namespace RDK_AT
+{
+
+// Indexed by EventMajor
+static const char* const kMajorNames[EVENT_MAJOR_COUNT] = {
+    "",
+    "focus",
+    "PropertyChange",
+    "state-changed",
+    "create",
+    "destroy",
+    "minimize",
+    "maximize",
+    "restore",
+    "activate",
+    "deactivate",
+    "load-complete",
+    "reload",
+    "load-stopped",
+    "visible-data-changed",
+    "children-changed",
+    "active-descendant-changed",
+    "row-inserted",
+    "row-reordered",
+    "row-deleted",
+    "column-inserted",
+    "column-reordered",
+    "column-deleted",
+    "model-changed",
+    "text-changed",
+    "text-insert",
+    "text-remove",
+    "text-caret-moved",
+    "text-attributes-changed",
+    "text-selection-changed",
+    "bounds-changed",
+    "selection-changed",
+    "link-selected"
+};
+
+// Indexed by EventMinor
+static const char* const kMinorNames[EVENT_MINOR_COUNT] = {
+    "",
+    "other",
+    "focused",
+    "checked",
+    "selected",
+    "expanded",
+    "pressed",
+    "busy",
+    "accessible-name",
+    "accessible-description",
+    "accessible-parent",
+    "accessible-role",
+    "accessible-table-summary",
+    "accessible-table-column-header",
+    "accessible-table-row-header",
+    "accessible-table-row-description",
+    "accessible-table-column-description",
+    "accessible-table-caption-object",
+    "insert",
+    "delete",
+    "add",
+    "remove"
+};
+
+// Quarks are small sequential integers, so a quark indexes this directly
+static std::vector<uint8_t> gMinorByQuark;
+
+void initEventTypes()
+{
+    if(!gMinorByQuark.empty())
+        return;
+
+    GQuark quarks[EVENT_MINOR_COUNT] = {0};
+    GQuark maxQuark = 0;
+    for(int i = EVENT_MINOR_FOCUSED; i < EVENT_MINOR_COUNT; i++) {
+        quarks[i] = g_quark_from_static_string(kMinorNames[i]);
+        if(quarks[i] > maxQuark)
+            maxQuark = quarks[i];
+    }
+
+    gMinorByQuark.assign(maxQuark + 1, EVENT_MINOR_OTHER);
+    gMinorByQuark[0] = EVENT_MINOR_NONE;
+    for(int i = EVENT_MINOR_FOCUSED; i < EVENT_MINOR_COUNT; i++)
+        gMinorByQuark[quarks[i]] = i;
+}
+
+EventMajor eventMajorFromName(const gchar *name)
+{
+    if(!name)
+        return EVENT_MAJOR_UNKNOWN;
+
+    // Called once per signal id (see SignalCache), a linear scan is fine
+    for(int i = EVENT_MAJOR_FOCUS; i < EVENT_MAJOR_COUNT; i++) {
+        if(strcmp(name, kMajorNames[i]) == 0)
+            return static_cast<EventMajor>(i);
+    }
+    return EVENT_MAJOR_UNKNOWN;
+}
+
+EventMinor eventMinorFromQuark(GQuark quark)
+{
+    if(quark < gMinorByQuark.size())
+        return static_cast<EventMinor>(gMinorByQuark[quark]);
+    return EVENT_MINOR_OTHER;
+}
+
+EventMinor eventMinorFromString(const gchar *name)
+{
+    if(!name || !*name)
+        return EVENT_MINOR_NONE;
+
+    GQuark quark = g_quark_try_string(name);
+    return quark ? eventMinorFromQuark(quark) : EVENT_MINOR_OTHER;
+}
+
+const char* eventMajorName(EventMajor major)
+{
+    return major < EVENT_MAJOR_COUNT ? kMajorNames[major] : "";
+}
+
+const char* eventMinorName(EventMinor minor)
+{
+    return minor < EVENT_MINOR_COUNT ? kMinorNames[minor] : "";
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,124 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_EVENT_TYPES_H
+#define RDK_AT_EVENT_TYPES_H
+
+#include <glib.h>
+#include <stdint.h>
+
+namespace RDK_AT
+{
+
+/**
+ * Event taxonomy. Majors correspond to the ATK signals we listen to,
+ * minors to signal details, state names and property names.
+ * Both start with 0 and increase w/o gaps as they index the dispatch table.
+ */
+enum EventMajor : uint8_t {
+    EVENT_MAJOR_UNKNOWN = 0,
+    EVENT_MAJOR_FOCUS,
+    EVENT_MAJOR_PROPERTY_CHANGE,
+    EVENT_MAJOR_STATE_CHANGED,
+    EVENT_MAJOR_WINDOW_CREATE,
+    EVENT_MAJOR_WINDOW_DESTROY,
+    EVENT_MAJOR_WINDOW_MINIMIZE,
+    EVENT_MAJOR_WINDOW_MAXIMIZE,
+    EVENT_MAJOR_WINDOW_RESTORE,
+    EVENT_MAJOR_WINDOW_ACTIVATE,
+    EVENT_MAJOR_WINDOW_DEACTIVATE,
+    EVENT_MAJOR_LOAD_COMPLETE,
+    EVENT_MAJOR_RELOAD,
+    EVENT_MAJOR_LOAD_STOPPED,
+    EVENT_MAJOR_VISIBLE_DATA_CHANGED,
+    EVENT_MAJOR_CHILDREN_CHANGED,
+    EVENT_MAJOR_ACTIVE_DESCENDANT_CHANGED,
+    EVENT_MAJOR_ROW_INSERTED,
+    EVENT_MAJOR_ROW_REORDERED,
+    EVENT_MAJOR_ROW_DELETED,
+    EVENT_MAJOR_COLUMN_INSERTED,
+    EVENT_MAJOR_COLUMN_REORDERED,
+    EVENT_MAJOR_COLUMN_DELETED,
+    EVENT_MAJOR_MODEL_CHANGED,
+    EVENT_MAJOR_TEXT_CHANGED,
+    EVENT_MAJOR_TEXT_INSERT,
+    EVENT_MAJOR_TEXT_REMOVE,
+    EVENT_MAJOR_TEXT_CARET_MOVED,
+    EVENT_MAJOR_TEXT_ATTRIBUTES_CHANGED,
+    EVENT_MAJOR_TEXT_SELECTION_CHANGED,
+    EVENT_MAJOR_BOUNDS_CHANGED,
+    EVENT_MAJOR_SELECTION_CHANGED,
+    EVENT_MAJOR_LINK_SELECTED,
+    EVENT_MAJOR_COUNT
+};
+
+enum EventMinor : uint8_t {
+    EVENT_MINOR_NONE = 0,
+    EVENT_MINOR_OTHER,
+
+    // state-changed
+    EVENT_MINOR_FOCUSED,
+    EVENT_MINOR_CHECKED,
+    EVENT_MINOR_SELECTED,
+    EVENT_MINOR_EXPANDED,
+    EVENT_MINOR_PRESSED,
+    EVENT_MINOR_BUSY,
+
+    // PropertyChange
+    EVENT_MINOR_ACCESSIBLE_NAME,
+    EVENT_MINOR_ACCESSIBLE_DESCRIPTION,
+    EVENT_MINOR_ACCESSIBLE_PARENT,
+    EVENT_MINOR_ACCESSIBLE_ROLE,
+    EVENT_MINOR_TABLE_SUMMARY,
+    EVENT_MINOR_TABLE_COLUMN_HEADER,
+    EVENT_MINOR_TABLE_ROW_HEADER,
+    EVENT_MINOR_TABLE_ROW_DESCRIPTION,
+    EVENT_MINOR_TABLE_COLUMN_DESCRIPTION,
+    EVENT_MINOR_TABLE_CAPTION_OBJECT,
+
+    // text-changed
+    EVENT_MINOR_TEXT_INSERT,
+    EVENT_MINOR_TEXT_DELETE,
+
+    // children-changed
+    EVENT_MINOR_CHILD_ADD,
+    EVENT_MINOR_CHILD_REMOVE,
+
+    EVENT_MINOR_COUNT
+};
+
+/**
+ * @brief Interns all known names, must be called once before classifying
+ */
+void initEventTypes();
+
+/**
+ * @brief Classification helpers
+ * The quark variant is an array lookup, the string variants resolve the
+ * string with g_quark_try_string() which neither allocates nor interns.
+ */
+EventMajor eventMajorFromName(const gchar *name);
+EventMinor eventMinorFromQuark(GQuark quark);
+EventMinor eventMinorFromString(const gchar *name);
+
+const char* eventMajorName(EventMajor major);
+const char* eventMinorName(EventMinor minor);
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_EVENT_TYPES_H
@@ -0,0 +1,132 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "focus_coalescer.h"
+#include "logger.h"
+
+#include <stdlib.h>
+
+namespace RDK_AT
+{
+
+static const guint kDefaultQuietWindowMs = 60;
+
+// Ready time based source, re-armed on every push w/o allocating a new timeout
+GSourceFuncs FocusCoalescer::s_sourceFuncs = {
+    NULL,
+    NULL,
+    FocusCoalescer::Dispatch,
+    NULL
+};
+
+FocusCoalescer::FocusCoalescer() :
+    m_source(NULL),
+    m_pending(NULL),
+    m_pendingEventNs(0),
+    m_cb(NULL),
+    m_cbData(NULL),
+    m_quietWindowMs(kDefaultQuietWindowMs),
+    m_superseded(0),
+    m_settled(0)
+{
+    const char *window = getenv("RDKAT_FOCUS_QUIET_MS");
+    if(window)
+        m_quietWindowMs = atoi(window);
+}
+
+FocusCoalescer::~FocusCoalescer()
+{
+    stop();
+}
+
+void FocusCoalescer::start(GMainContext *context, SettledCallback cb, void *data)
+{
+    if(m_source)
+        return;
+
+    m_cb = cb;
+    m_cbData = data;
+
+    m_source = g_source_new(&s_sourceFuncs, sizeof(TimerSource));
+    reinterpret_cast<TimerSource*>(m_source)->coalescer = this;
+    g_source_set_name(m_source, "rdkat-focus-coalescer");
+    g_source_set_ready_time(m_source, -1);
+    g_source_attach(m_source, context);
+}
+
+void FocusCoalescer::stop()
+{
+    cancel();
+    if(m_source) {
+        g_source_destroy(m_source);
+        g_source_unref(m_source);
+        m_source = NULL;
+    }
+}
+
+void FocusCoalescer::push(AtkObject *obj, uint64_t eventNs)
+{
+    if(m_pending) {
+        RDKLOG_VERBOSE("Focus on %p superseded by %p", m_pending, obj);
+        g_object_unref(m_pending);
+        m_superseded++;
+    }
+    m_pending = ATK_OBJECT(g_object_ref(obj));
+    m_pendingEventNs = eventNs;
+
+    if(m_quietWindowMs == 0 || !m_source) {
+        settle();
+        return;
+    }
+
+    g_source_set_ready_time(m_source, g_get_monotonic_time() + m_quietWindowMs * 1000);
+}
+
+void FocusCoalescer::cancel()
+{
+    if(m_source)
+        g_source_set_ready_time(m_source, -1);
+
+    if(m_pending) {
+        g_object_unref(m_pending);
+        m_pending = NULL;
+    }
+}
+
+void FocusCoalescer::settle()
+{
+    AtkObject *obj = m_pending;
+    m_pending = NULL;
+    if(!obj)
+        return;
+
+    m_settled++;
+    if(m_cb)
+        m_cb(obj, m_pendingEventNs, m_cbData);
+    g_object_unref(obj);
+}
+
+gboolean FocusCoalescer::Dispatch(GSource *source, GSourceFunc, gpointer)
+{
+    g_source_set_ready_time(source, -1);
+    reinterpret_cast<TimerSource*>(source)->coalescer->settle();
+    return G_SOURCE_CONTINUE;
+}
+
+} // namespace RDK_AT
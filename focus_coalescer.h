@@ -0,0 +1,84 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_FOCUS_COALESCER_H
+#define RDK_AT_FOCUS_COALESCER_H
+
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stdint.h>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Holds back focus events until focus has been stable for a quiet window.
+ *
+ * A newer focus event replaces the pending one before any accessibility
+ * info is fetched for it, so only the element the user settles on gets
+ * queried and spoken. The quiet window is read from RDKAT_FOCUS_QUIET_MS
+ * (default 60), 0 disables coalescing.
+ *
+ * Lives on the thread which emits ATK signals.
+ */
+class FocusCoalescer {
+public:
+    // eventNs is when the settled focus event was received, see stat_now_ns()
+    typedef void (*SettledCallback)(AtkObject *obj, uint64_t eventNs, void *data);
+
+    FocusCoalescer();
+    ~FocusCoalescer();
+
+    void start(GMainContext *context, SettledCallback cb, void *data);
+    void stop();
+
+    void push(AtkObject *obj, uint64_t eventNs);
+    void cancel();
+
+    guint quietWindowMs() const { return m_quietWindowMs; }
+    uint64_t supersededCount() const { return m_superseded; }
+    uint64_t settledCount() const { return m_settled; }
+
+private:
+    FocusCoalescer(const FocusCoalescer &);
+    FocusCoalescer& operator=(const FocusCoalescer &);
+
+    void settle();
+    static gboolean Dispatch(GSource *source, GSourceFunc, gpointer);
+    static GSourceFuncs s_sourceFuncs;
+
+    struct TimerSource {
+        GSource source;
+        FocusCoalescer *coalescer;
+    };
+
+    GSource *m_source;
+    AtkObject *m_pending;
+    uint64_t m_pendingEventNs;
+    SettledCallback m_cb;
+    void *m_cbData;
+    guint m_quietWindowMs;
+    StatCounter m_superseded;
+    StatCounter m_settled;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_FOCUS_COALESCER_H
@@ -0,0 +1,133 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "listener_set.h"
+#include "logger.h"
+
+#include <atk/atk.h>
+#include <stdlib.h>
+
+#include <atomic>
+
+namespace RDK_AT
+{
+
+// ATK doesn't pass user data to global event listeners, hence the counter is process wide
+static std::atomic<uint64_t> gAvoidedInvocations(0);
+
+ListenerSet::ListenerSet(const ListenerEntry *entries, size_t count, const EventFilter *filter) :
+    m_entries(entries),
+    m_filter(filter),
+    m_count(count),
+    m_ids(g_new0(guint, count)),
+    m_countIds(g_new0(guint, count)),
+    m_groups(LISTENER_GROUP_NONE),
+    m_applied(false),
+    m_countAvoided(getenv("RDKAT_COUNT_AVOIDED_EVENTS") != NULL)
+{
+}
+
+ListenerSet::~ListenerSet()
+{
+    update(LISTENER_GROUP_NONE);
+    if(m_countAvoided) {
+        for(size_t i = 0; i < m_count; i++) {
+            if(m_countIds[i])
+                atk_remove_global_event_listener(m_countIds[i]);
+        }
+    }
+    g_free(m_ids);
+    g_free(m_countIds);
+}
+
+gboolean ListenerSet::CountingListener(GSignalInvocationHint *, guint, const GValue *, gpointer)
+{
+    gAvoidedInvocations.fetch_add(1, std::memory_order_relaxed);
+    return TRUE;
+}
+
+guint ListenerSet::attach(GSignalEmissionHook listener, size_t index)
+{
+    const ListenerEntry &entry = m_entries[index];
+    guint id = atk_add_global_event_listener(listener, entry.signal_name);
+    if(id == 0 && entry.fallback_name)
+        id = atk_add_global_event_listener(listener, entry.fallback_name);
+
+    if(id == 0)
+        RDKLOG_WARNING("Unable to add listener for \"%s\"", entry.signal_name);
+    return id;
+}
+
+bool ListenerSet::filtered(const ListenerEntry &entry) const
+{
+    if(!m_filter)
+        return false;
+    if(entry.minor == EVENT_MINOR_NONE)
+        return !m_filter->passesMajor(entry.major);
+    return !m_filter->passes(entry.major, entry.minor);
+}
+
+void ListenerSet::update(unsigned groups)
+{
+    if(m_applied && groups == m_groups)
+        return;
+
+    size_t attached = 0, detached = 0;
+    for(size_t i = 0; i < m_count; i++) {
+        bool needed = (m_entries[i].groups & groups) != 0 && !filtered(m_entries[i]);
+
+        if(needed && !m_ids[i]) {
+            if(m_countIds[i]) {
+                atk_remove_global_event_listener(m_countIds[i]);
+                m_countIds[i] = 0;
+            }
+            m_ids[i] = attach(m_entries[i].listener, i);
+            attached++;
+        } else if(!needed && m_ids[i]) {
+            atk_remove_global_event_listener(m_ids[i]);
+            m_ids[i] = 0;
+            detached++;
+        }
+
+        if(!needed && m_countAvoided && !m_countIds[i])
+            m_countIds[i] = attach(CountingListener, i);
+    }
+
+    RDKLOG_INFO("Listener groups 0x%x -> 0x%x, attached=%zu, detached=%zu, active=%zu, avoided invocations=%llu",
+        m_groups, groups, attached, detached, attachedCount(), (unsigned long long)avoidedInvocations());
+    m_groups = groups;
+    m_applied = true;
+}
+
+size_t ListenerSet::attachedCount() const
+{
+    size_t n = 0;
+    for(size_t i = 0; i < m_count; i++) {
+        if(m_ids[i])
+            n++;
+    }
+    return n;
+}
+
+uint64_t ListenerSet::avoidedInvocations()
+{
+    return gAvoidedInvocations.load(std::memory_order_relaxed);
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,93 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_LISTENER_SET_H
+#define RDK_AT_LISTENER_SET_H
+
+#include "event_filter.h"
+
+#include <glib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace RDK_AT
+{
+
+/**
+ * Groups a global event listener can belong to.
+ * A listener stays attached to ATK while at least one of its groups is active
+ * and the event filter keeps some of what it reports.
+ */
+enum ListenerGroup {
+    LISTENER_GROUP_NONE   = 0,
+    LISTENER_GROUP_SPEECH = 1 << 0, // events which may end up in an utterance
+    LISTENER_GROUP_DEBUG  = 1 << 1  // events which are only logged
+};
+
+struct ListenerEntry {
+    GSignalEmissionHook listener;
+    const char *signal_name;
+    const char *fallback_name; // registered instead when signal_name is not supported, may be NULL
+    unsigned groups;
+    EventMajor major;   // what the listener reports, to skip it when filtered out
+    EventMinor minor;   // EVENT_MINOR_NONE for any
+};
+
+/**
+ * @brief Attaches / detaches a fixed table of ATK global event listeners
+ * depending on the groups that are currently active.
+ *
+ * When RDKAT_COUNT_AVOIDED_EVENTS is set in the environment, a counting only
+ * hook is kept on the detached signals to report how many listener
+ * invocations were avoided. It is off by default as any emission hook keeps
+ * GSignal on its slow emission path.
+ */
+class ListenerSet {
+public:
+    ListenerSet(const ListenerEntry *entries, size_t count, const EventFilter *filter = NULL);
+    ~ListenerSet();
+
+    void update(unsigned groups);
+    unsigned activeGroups() const { return m_groups; }
+    size_t attachedCount() const;
+    static uint64_t avoidedInvocations(); // process wide, readable from any thread
+
+private:
+    ListenerSet(const ListenerSet &);
+    ListenerSet& operator=(const ListenerSet &);
+
+    guint attach(GSignalEmissionHook listener, size_t index);
+
+    static gboolean CountingListener(GSignalInvocationHint *signal,
+            guint param_count, const GValue *params, gpointer data);
+
+    bool filtered(const ListenerEntry &entry) const;
+
+    const ListenerEntry *m_entries;
+    const EventFilter *m_filter;
+    size_t m_count;
+    guint *m_ids;       // id of the real listener, 0 when detached
+    guint *m_countIds;  // id of the counting hook, 0 when not installed
+    unsigned m_groups;
+    bool m_applied;
+    bool m_countAvoided;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_LISTENER_SET_H
@@ -0,0 +1,416 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "live_regions.h"
+#include "logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace RDK_AT
+{
+
+static const guint kDefaultMaxObjects = 512;
+static const guint kDefaultWindowMs = 300;
+static const guint kDefaultIntervalMs = 2000;
+static const size_t kMaxPending = 512; // bytes aggregated per region, older updates are dropped past it
+static const int kMaxDepth = 32;       // from an object up to its region root
+
+GSourceFuncs LiveRegions::s_sourceFuncs = {
+    NULL,
+    NULL,
+    LiveRegions::Dispatch,
+    NULL
+};
+
+LiveRegions::LiveRegions() :
+    m_source(NULL),
+    m_cb(NULL),
+    m_cbData(NULL),
+    m_objects(g_hash_table_new(g_direct_hash, g_direct_equal)),
+    m_regions(g_hash_table_new(g_direct_hash, g_direct_equal)),
+    m_maxObjects(kDefaultMaxObjects),
+    m_windowUs(kDefaultWindowMs * 1000),
+    m_intervalUs(kDefaultIntervalMs * 1000),
+    m_attributeFetches(0),
+    m_updates(0),
+    m_coalesced(0),
+    m_announcements(0)
+{
+    g_queue_init(&m_lru);
+
+    const char *ms = getenv("RDKAT_LIVE_WINDOW_MS");
+    if(ms)
+        m_windowUs = (gint64)atoi(ms) * 1000;
+    ms = getenv("RDKAT_LIVE_INTERVAL_MS");
+    if(ms)
+        m_intervalUs = (gint64)atoi(ms) * 1000;
+}
+
+LiveRegions::~LiveRegions()
+{
+    stop();
+    clear();
+    g_hash_table_destroy(m_objects);
+    g_hash_table_destroy(m_regions);
+}
+
+void LiveRegions::start(GMainContext *context, AnnounceCallback cb, void *data)
+{
+    if(m_source)
+        return;
+
+    m_cb = cb;
+    m_cbData = data;
+
+    m_source = g_source_new(&s_sourceFuncs, sizeof(TimerSource));
+    reinterpret_cast<TimerSource*>(m_source)->regions = this;
+    g_source_set_name(m_source, "rdkat-live-regions");
+    g_source_set_ready_time(m_source, -1);
+    g_source_attach(m_source, context);
+}
+
+void LiveRegions::stop()
+{
+    clear();
+    if(m_source) {
+        g_source_destroy(m_source);
+        g_source_unref(m_source);
+        m_source = NULL;
+    }
+}
+
+void LiveRegions::ObjectFinalized(gpointer data, GObject *obj)
+{
+    LiveRegions *self = static_cast<LiveRegions*>(data);
+    CachedObject *entry = static_cast<CachedObject*>(g_hash_table_lookup(self->m_objects, obj));
+    if(!entry)
+        return;
+    g_queue_unlink(&self->m_lru, &entry->link);
+    g_hash_table_remove(self->m_objects, obj);
+    delete entry;
+}
+
+void LiveRegions::RegionFinalized(gpointer data, GObject *root)
+{
+    // Never queued, the queue holds a reference
+    LiveRegions *self = static_cast<LiveRegions*>(data);
+    Region *region = static_cast<Region*>(g_hash_table_lookup(self->m_regions, root));
+    g_hash_table_remove(self->m_regions, root);
+
+    // Objects may still point to it
+    self->forgetRegion(region);
+    delete region;
+}
+
+LiveRegions::Region* LiveRegions::createRegion(AtkObject *root, const char *live, const char *atomic, const char *relevant)
+{
+    Region *region = new Region();
+    region->root = root;
+    region->assertive = !strcmp(live, "assertive");
+    region->atomic = atomic && !strcmp(atomic, "true");
+    region->relevant = RELEVANT_ADDITIONS | RELEVANT_TEXT;
+    if(relevant) {
+        region->relevant = 0;
+        if(strstr(relevant, "additions"))
+            region->relevant |= RELEVANT_ADDITIONS;
+        if(strstr(relevant, "removals"))
+            region->relevant |= RELEVANT_REMOVALS;
+        if(strstr(relevant, "text"))
+            region->relevant |= RELEVANT_TEXT;
+        if(strstr(relevant, "all"))
+            region->relevant = RELEVANT_ADDITIONS | RELEVANT_REMOVALS | RELEVANT_TEXT;
+    }
+    region->queued = false;
+    region->due = 0;
+    region->lastAnnounced = 0;
+    region->eventNs = 0;
+
+    RDKLOG_VERBOSE("Live region %p, live=%s, atomic=%d, relevant=0x%x", root, live, region->atomic, region->relevant);
+    g_object_weak_ref(G_OBJECT(root), RegionFinalized, this);
+    g_hash_table_insert(m_regions, root, region);
+    return region;
+}
+
+LiveRegions::CachedObject* LiveRegions::cached(AtkObject *obj)
+{
+    CachedObject *entry = static_cast<CachedObject*>(g_hash_table_lookup(m_objects, obj));
+    if(entry && m_lru.head != &entry->link) {
+        g_queue_unlink(&m_lru, &entry->link);
+        g_queue_push_head_link(&m_lru, &entry->link);
+    }
+    return entry;
+}
+
+void LiveRegions::cache(AtkObject *obj, Region *region)
+{
+    // Evicting the least recently used objects, rather than flushing, keeps the ones
+    // events keep coming from while a page build goes through new objects
+    while(g_hash_table_size(m_objects) >= m_maxObjects && m_lru.tail)
+        forget(static_cast<CachedObject*>(m_lru.tail->data));
+
+    CachedObject *entry = new CachedObject();
+    entry->obj = obj;
+    entry->region = region;
+    entry->link.data = entry;
+    entry->link.next = entry->link.prev = NULL;
+    g_queue_push_head_link(&m_lru, &entry->link);
+    g_object_weak_ref(G_OBJECT(obj), ObjectFinalized, this);
+    g_hash_table_insert(m_objects, obj, entry);
+}
+
+void LiveRegions::forget(CachedObject *entry)
+{
+    g_queue_unlink(&m_lru, &entry->link);
+    g_object_weak_unref(G_OBJECT(entry->obj), ObjectFinalized, this);
+    g_hash_table_remove(m_objects, entry->obj);
+    delete entry;
+}
+
+void LiveRegions::forgetRegion(Region *region)
+{
+    GHashTableIter iter;
+    gpointer value;
+    g_hash_table_iter_init(&iter, m_objects);
+    while(g_hash_table_iter_next(&iter, NULL, &value)) {
+        CachedObject *entry = static_cast<CachedObject*>(value);
+        if(entry->region != region)
+            continue;
+        g_queue_unlink(&m_lru, &entry->link);
+        g_object_weak_unref(G_OBJECT(entry->obj), ObjectFinalized, this);
+        g_hash_table_iter_remove(&iter);
+        delete entry;
+    }
+}
+
+LiveRegions::Region* LiveRegions::lookup(AtkObject *obj)
+{
+    CachedObject *entry = cached(obj);
+    if(entry)
+        return entry->region;
+
+    // WebKit marks the descendants of a region with container-live, the root with live
+    Region *region = NULL;
+    AtkObject *o = obj;
+    for(int depth = 0; o && depth < kMaxDepth; depth++, o = atk_object_get_parent(o)) {
+        if(o != obj && (entry = cached(o))) {
+            region = entry->region;
+            break;
+        }
+        region = static_cast<Region*>(g_hash_table_lookup(m_regions, o));
+        if(region)
+            break;
+
+        AtkAttributeSet *attributes = atk_object_get_attributes(o);
+        m_attributeFetches++;
+        const char *live = NULL, *atomic = NULL, *relevant = NULL;
+        bool inRegion = false;
+        for(GSList *l = attributes; l; l = l->next) {
+            AtkAttribute *attribute = static_cast<AtkAttribute*>(l->data);
+            if(!strcmp(attribute->name, "live"))
+                live = attribute->value;
+            else if(!strcmp(attribute->name, "atomic"))
+                atomic = attribute->value;
+            else if(!strcmp(attribute->name, "relevant"))
+                relevant = attribute->value;
+            else if(!strcmp(attribute->name, "container-live"))
+                inRegion = strcmp(attribute->value, "off") != 0;
+        }
+        if(live && strcmp(live, "off"))
+            region = createRegion(o, live, atomic, relevant);
+        atk_attribute_set_free(attributes);
+
+        if(region || !inRegion)
+            break;
+    }
+
+    cache(obj, region);
+    return region;
+}
+
+std::string LiveRegions::objectText(AtkObject *obj)
+{
+    std::string text;
+    if(ATK_IS_TEXT(obj)) {
+        gchar *s = atk_text_get_text(ATK_TEXT(obj), 0, -1);
+        if(s) {
+            text = s;
+            g_free(s);
+        }
+    }
+    if(text.empty()) {
+        const gchar *name = atk_object_get_name(obj);
+        if(name)
+            text = name;
+    }
+    return text;
+}
+
+bool LiveRegions::childAdded(AtkObject *parent, AtkObject *child, uint64_t eventNs)
+{
+    Region *region = lookup(parent);
+    if(!region)
+        return false;
+    if(region->relevant & RELEVANT_ADDITIONS)
+        update(region, region->atomic || !child ? NULL : objectText(child).c_str(), eventNs);
+    return true;
+}
+
+bool LiveRegions::textInserted(AtkObject *obj, const char *text, uint64_t eventNs)
+{
+    Region *region = lookup(obj);
+    if(!region)
+        return false;
+    if(region->relevant & RELEVANT_TEXT)
+        update(region, text, eventNs);
+    return true;
+}
+
+bool LiveRegions::textRemoved(AtkObject *obj, const char *text, uint64_t eventNs)
+{
+    Region *region = lookup(obj);
+    if(!region)
+        return false;
+    if(region->relevant & RELEVANT_REMOVALS)
+        update(region, text, eventNs);
+    return true;
+}
+
+void LiveRegions::update(Region *region, const char *text, uint64_t eventNs)
+{
+    m_updates++;
+
+    // An atomic region is read as a whole when announced
+    if(!region->atomic && text && *text) {
+        if(region->pending.size() + strlen(text) > kMaxPending)
+            region->pending.clear();
+        if(!region->pending.empty())
+            region->pending += ' ';
+        region->pending += text;
+    }
+
+    if(region->queued) {
+        m_coalesced++;
+        return;
+    }
+    if(!region->atomic && region->pending.empty())
+        return;
+
+    gint64 now = g_get_monotonic_time();
+    region->queued = true;
+    region->eventNs = eventNs;
+    region->due = MAX(now + m_windowUs, region->lastAnnounced + m_intervalUs);
+    g_object_ref(region->root);
+    m_queued.push_back(region);
+
+    if(m_source) {
+        rearm();
+        return;
+    }
+    region->due = now;
+    announceDue();
+}
+
+void LiveRegions::announceDue()
+{
+    gint64 now = g_get_monotonic_time();
+    for(size_t i = 0; i < m_queued.size();) {
+        Region *region = m_queued[i];
+        if(region->due > now) {
+            i++;
+            continue;
+        }
+        m_queued.erase(m_queued.begin() + i);
+
+        AtkObject *root = region->root;
+        std::string text = region->atomic ? objectText(root) : region->pending;
+        region->pending.clear();
+        region->queued = false;
+        region->lastAnnounced = now;
+
+        if(!text.empty() && m_cb) {
+            m_announcements++;
+            m_cb(root, text, region->assertive ? SPEECH_PRIORITY_STATE : SPEECH_PRIORITY_LIVE, region->eventNs, m_cbData);
+        }
+
+        // May finalize the root, hence delete the region
+        g_object_unref(root);
+    }
+    rearm();
+}
+
+void LiveRegions::rearm()
+{
+    if(!m_source)
+        return;
+
+    gint64 due = -1;
+    for(size_t i = 0; i < m_queued.size(); i++) {
+        if(due < 0 || m_queued[i]->due < due)
+            due = m_queued[i]->due;
+    }
+    g_source_set_ready_time(m_source, due);
+}
+
+gboolean LiveRegions::Dispatch(GSource *source, GSourceFunc, gpointer)
+{
+    g_source_set_ready_time(source, -1);
+    reinterpret_cast<TimerSource*>(source)->regions->announceDue();
+    return G_SOURCE_CONTINUE;
+}
+
+void LiveRegions::clearObjects()
+{
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, m_objects);
+    while(g_hash_table_iter_next(&iter, &key, &value)) {
+        g_object_weak_unref(G_OBJECT(key), ObjectFinalized, this);
+        delete static_cast<CachedObject*>(value);
+    }
+    g_hash_table_remove_all(m_objects);
+    g_queue_init(&m_lru);
+}
+
+void LiveRegions::clear()
+{
+    // Unreferencing a queued root may finalize it, the queue is emptied first
+    std::vector<Region*> queued;
+    queued.swap(m_queued);
+    for(size_t i = 0; i < queued.size(); i++) {
+        queued[i]->queued = false;
+        queued[i]->pending.clear();
+        g_object_unref(queued[i]->root);
+    }
+    if(m_source)
+        g_source_set_ready_time(m_source, -1);
+
+    clearObjects();
+
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, m_regions);
+    while(g_hash_table_iter_next(&iter, &key, &value)) {
+        g_object_weak_unref(G_OBJECT(key), RegionFinalized, this);
+        delete static_cast<Region*>(value);
+    }
+    g_hash_table_remove_all(m_regions);
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,143 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_LIVE_REGIONS_H
+#define RDK_AT_LIVE_REGIONS_H
+
+#include "speech_scheduler.h"
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Announces the updates of ARIA live regions, throttled per region.
+ *
+ * The region an object belongs to is found from the live / container-live
+ * object attributes WebKit exposes, walking up to the element carrying
+ * "live". Results are cached per object through GObject weak references, so
+ * that attributes are fetched once per object; past 512 objects the least
+ * recently used ones are evicted.
+ *
+ * Updates of a region are aggregated for RDKAT_LIVE_WINDOW_MS (default 300),
+ * then announced at most every RDKAT_LIVE_INTERVAL_MS (default 2000), so that
+ * tickers & progress banners don't flood the speech queue. An atomic region
+ * is announced as a whole, from its latest content. Polite regions are
+ * spoken as SPEECH_PRIORITY_LIVE, assertive ones as SPEECH_PRIORITY_STATE.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class LiveRegions {
+public:
+    // eventNs is when the first aggregated update was received, see stat_now_ns()
+    typedef void (*AnnounceCallback)(AtkObject *region, const std::string &text,
+            SpeechPriority priority, uint64_t eventNs, void *data);
+
+    LiveRegions();
+    ~LiveRegions();
+
+    void start(GMainContext *context, AnnounceCallback cb, void *data);
+    void stop();
+
+    // Return false when obj isn't in a live region
+    bool childAdded(AtkObject *parent, AtkObject *child, uint64_t eventNs);
+    bool textInserted(AtkObject *obj, const char *text, uint64_t eventNs);
+    bool textRemoved(AtkObject *obj, const char *text, uint64_t eventNs);
+    void clear();
+
+    uint64_t attributeFetches() const { return m_attributeFetches; }
+    uint64_t updates() const { return m_updates; }
+    uint64_t coalesced() const { return m_coalesced; }
+    uint64_t announcements() const { return m_announcements; }
+
+private:
+    LiveRegions(const LiveRegions &);
+    LiveRegions& operator=(const LiveRegions &);
+
+    enum Relevant {
+        RELEVANT_ADDITIONS = 1 << 0,
+        RELEVANT_REMOVALS  = 1 << 1,
+        RELEVANT_TEXT      = 1 << 2
+    };
+
+    struct Region {
+        AtkObject *root;
+        bool assertive;
+        bool atomic;
+        unsigned relevant;
+        bool queued;        // root is referenced while queued
+        gint64 due;
+        gint64 lastAnnounced;
+        uint64_t eventNs;
+        std::string pending; // aggregated updates, unused when atomic
+    };
+
+    struct CachedObject {
+        AtkObject *obj;
+        Region *region; // NULL when not in a live region
+        GList link;     // in m_lru
+    };
+
+    Region* lookup(AtkObject *obj);
+    CachedObject* cached(AtkObject *obj); // marks it as recently used
+    void cache(AtkObject *obj, Region *region);
+    void forget(CachedObject *entry);
+    void forgetRegion(Region *region);
+    Region* createRegion(AtkObject *root, const char *live, const char *atomic, const char *relevant);
+    void update(Region *region, const char *text, uint64_t eventNs);
+    void announceDue();
+    void rearm();
+    void clearObjects();
+
+    static std::string objectText(AtkObject *obj);
+    static gboolean Dispatch(GSource *source, GSourceFunc, gpointer);
+    static GSourceFuncs s_sourceFuncs;
+    static void ObjectFinalized(gpointer data, GObject *obj);
+    static void RegionFinalized(gpointer data, GObject *root);
+
+    struct TimerSource {
+        GSource source;
+        LiveRegions *regions;
+    };
+
+    GSource *m_source;
+    AnnounceCallback m_cb;
+    void *m_cbData;
+    GHashTable *m_objects; // AtkObject* -> CachedObject*, owned
+    GQueue m_lru;          // CachedObject, most recently used first
+    GHashTable *m_regions; // root AtkObject* -> Region*, owned
+    std::vector<Region*> m_queued;
+    guint m_maxObjects;
+    gint64 m_windowUs;
+    gint64 m_intervalUs;
+    StatCounter m_attributeFetches;
+    StatCounter m_updates;
+    StatCounter m_coalesced;
+    StatCounter m_announcements;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_LIVE_REGIONS_H
@@ -23,6 +23,16 @@
 #include <cstdarg>
 #include <cstdlib>
 #include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#ifndef USE_RDK_LOGGER
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 #ifdef USE_RDK_LOGGER
 #include "rdk_debug.h"
@@ -31,6 +41,8 @@
 namespace RDK_AT
 {
 
+std::atomic<int> gEnabledLogLevel(INFO_LEVEL);
+
 static inline void sync_stdout()
 {
     if (getenv("SYNC_STDOUT"))
@@ -46,6 +58,20 @@ void logger_init()
 {
     sync_stdout();
     rdk_logger_init("/etc/debug.ini");
+    logger_refresh();
+}
+
+void logger_refresh()
+{
+    // log4c levels are ordered, the most detailed enabled one gives the threshold
+    int enabled = FATAL_LEVEL;
+    for (int level = TRACE_LEVEL; level > FATAL_LEVEL; level--) {
+        if (TRUE == rdk_dbg_enabled("LOG.RDK.RDKAT", levelMap[level])) {
+            enabled = level;
+            break;
+        }
+    }
+    gEnabledLogLevel.store(enabled, std::memory_order_relaxed);
 }
 
 void log(LogLevel level,
@@ -83,26 +109,265 @@ void log(LogLevel level,
         std::abort();
 }
 
-bool is_log_level_enabled(LogLevel level)
+uint64_t log_dropped_count()
 {
-    return TRUE == rdk_dbg_enabled("LOG.RDK.RDKAT",levelMap[static_cast<int>(level)]);
+    return 0;
 }
 
 #else
 
-static int gDefaultLogLevel = INFO_LEVEL;
+static const char* const kLevelNames[] = {"Fatal", "Error", "Warning", "Info", "Verbose", "Trace"};
+
+static int current_thread_id()
+{
+    static thread_local int tid = 0;
+    if (!tid)
+        tid = static_cast<int>(syscall(SYS_gettid));
+    return tid;
+}
+
+static void write_line(const struct timespec &spec, LogLevel level,
+    const char* func, const char* file, int line, int threadID, const char* message)
+{
+    char timestamp[0xFF] = {0};
+    struct tm tm;
+
+    gmtime_r(&spec.tv_sec, &tm);
+    long ms = spec.tv_nsec / 1.0e6;
+
+    sprintf(timestamp, "%02d%02d%02d-%02d:%02d:%02d.%03ld",
+        tm.tm_year % 100,
+        tm.tm_mon + 1,
+        tm.tm_mday,
+        tm.tm_hour,
+        tm.tm_min,
+        tm.tm_sec,
+        ms);
+
+    printf("%s [%s] [tid=%d] %s:%s:%d %s\n",
+        timestamp,
+        kLevelNames[static_cast<int>(level)],
+        threadID,
+        func, basename(file), line,
+        message);
+}
+
+/**
+ * @brief Bounded lock-free multi-producer queue of log records, drained by a writer thread.
+ *
+ * Callers only take a timestamp and vsnprintf into a preallocated slot, as
+ * %s arguments are borrowed and can't outlive the call. Timestamp formatting,
+ * printf and fflush happen on the writer thread. When the ring is full the
+ * record is dropped and counted; the writer reports drops in the log.
+ * Set RDKAT_LOG_ASYNC=0 to log synchronously, RDKAT_LOG_RING_SIZE to size the
+ * ring (rounded up to a power of 2, default 512 records).
+ */
+class AsyncLogWriter
+{
+public:
+    static const size_t kMessageSize = 1024;
+
+    AsyncLogWriter()
+        : m_slots(NULL)
+        , m_mask(0)
+        , m_enqueuePos(0)
+        , m_dequeuePos(0)
+        , m_dropped(0)
+        , m_reportedDropped(0)
+        , m_running(false)
+        , m_sleeping(false)
+    {
+    }
+
+    ~AsyncLogWriter()
+    {
+        stop();
+    }
+
+    void start()
+    {
+        std::call_once(m_startOnce, [this]() {
+            const char* async = getenv("RDKAT_LOG_ASYNC");
+            if (async && atoi(async) == 0)
+                return;
+
+            size_t size = 512;
+            const char* ringSize = getenv("RDKAT_LOG_RING_SIZE");
+            if (ringSize && atoi(ringSize) > 0)
+                size = atoi(ringSize);
+
+            size_t capacity = 2;
+            while (capacity < size)
+                capacity <<= 1;
+
+            m_slots = new Slot[capacity];
+            for (size_t i = 0; i < capacity; i++)
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            m_mask = capacity - 1;
+
+            m_running.store(true, std::memory_order_release);
+            m_thread = std::thread(&AsyncLogWriter::run, this);
+        });
+    }
+
+    void stop()
+    {
+        if (!m_running.exchange(false))
+            return;
+
+        m_wakeup.notify_one();
+        if (m_thread.joinable())
+            m_thread.join();
+
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        drain();
+        fflush(stdout);
+    }
+
+    bool running() const { return m_running.load(std::memory_order_acquire); }
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // Returns false when the ring is full, the record is then counted as dropped
+    bool push(LogLevel level, const char* func, const char* file, int line, int threadID,
+        const char* format, va_list args)
+    {
+        Slot* slot;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &m_slots[pos & m_mask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        clock_gettime(CLOCK_REALTIME, &slot->time);
+        slot->level = level;
+        slot->func = func;
+        slot->file = file;
+        slot->line = line;
+        slot->threadID = threadID;
+        vsnprintf(slot->message, kMessageSize, format, args);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        if (m_sleeping.load(std::memory_order_relaxed))
+            m_wakeup.notify_one();
+        return true;
+    }
+
+    // Writes out everything queued so far from the calling thread, used before abort()
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        drain();
+        fflush(stdout);
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        struct timespec time;
+        LogLevel level;
+        const char* func;
+        const char* file;
+        int line;
+        int threadID;
+        char message[kMessageSize];
+    };
+
+    // Single consumer, callers hold m_drainMutex
+    size_t drain()
+    {
+        size_t written = 0;
+        for (;;) {
+            size_t pos = m_dequeuePos;
+            Slot &slot = m_slots[pos & m_mask];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+                break;
+
+            write_line(slot.time, slot.level, slot.func, slot.file, slot.line, slot.threadID, slot.message);
+            slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+            m_dequeuePos = pos + 1;
+            written++;
+        }
+
+        uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_reportedDropped) {
+            struct timespec spec;
+            char message[64];
+            clock_gettime(CLOCK_REALTIME, &spec);
+            snprintf(message, sizeof(message), "%llu log messages dropped",
+                (unsigned long long)(dropped - m_reportedDropped));
+            write_line(spec, WARNING_LEVEL, __func__, __FILE__, __LINE__, current_thread_id(), message);
+            m_reportedDropped = dropped;
+            written++;
+        }
+        return written;
+    }
+
+    void run()
+    {
+        while (m_running.load(std::memory_order_acquire)) {
+            size_t written;
+            {
+                std::lock_guard<std::mutex> lock(m_drainMutex);
+                written = drain();
+                if (written)
+                    fflush(stdout);
+            }
+            if (written)
+                continue;
+
+            // A producer may miss the sleeping flag, hence the bounded wait
+            std::unique_lock<std::mutex> lock(m_wakeupMutex);
+            m_sleeping.store(true, std::memory_order_relaxed);
+            m_wakeup.wait_for(lock, std::chrono::milliseconds(20));
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    Slot* m_slots;
+    size_t m_mask;
+    std::atomic<size_t> m_enqueuePos;
+    size_t m_dequeuePos;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_reportedDropped;
+
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_sleeping;
+    std::once_flag m_startOnce;
+    std::mutex m_drainMutex;
+    std::mutex m_wakeupMutex;
+    std::condition_variable m_wakeup;
+    std::thread m_thread;
+};
+
+static AsyncLogWriter gLogWriter;
 
 void logger_init()
 {
     sync_stdout();
+    logger_refresh();
+    gLogWriter.start();
+}
+
+void logger_refresh()
+{
     const char* level = getenv("RDKAT_DEFAULT_LOG_LEVEL");
     if (level)
-        gDefaultLogLevel = static_cast<LogLevel>(atoi(level));
+        gEnabledLogLevel.store(atoi(level), std::memory_order_relaxed);
 }
 
-bool is_log_level_enabled(LogLevel level)
+uint64_t log_dropped_count()
 {
-    return gDefaultLogLevel >= level;
+    return gLogWriter.dropped();
 }
 
 void log(LogLevel level,
@@ -112,53 +377,31 @@ void log(LogLevel level,
     int threadID,
     const char* format, ...)
 {
-    if (gDefaultLogLevel < level)
+    if (!threadID)
+        threadID = current_thread_id();
+
+    va_list argptr;
+    va_start(argptr, format);
+
+    if (FATAL_LEVEL != level && gLogWriter.running()) {
+        gLogWriter.push(level, func, file, line, threadID, format, argptr);
+        va_end(argptr);
         return;
+    }
 
-    const char* levelMap[] = {"Fatal", "Error", "Warning", "Info", "Verbose", "Trace"};
     const short kFormatMessageSize = 4096;
     char formatted[kFormatMessageSize];
-
-    va_list argptr;
-    va_start(argptr, format);
     vsnprintf(formatted, kFormatMessageSize, format, argptr);
     va_end(argptr);
 
-    char timestamp[0xFF] = {0};
     struct timespec spec;
-    struct tm tm;
-
     clock_gettime(CLOCK_REALTIME, &spec);
-    gmtime_r(&spec.tv_sec, &tm);
-    long ms = spec.tv_nsec / 1.0e6;
 
-    sprintf(timestamp, "%02d%02d%02d-%02d:%02d:%02d.%03ld",
-        tm.tm_year % 100,
-        tm.tm_mon + 1,
-        tm.tm_mday,
-        tm.tm_hour,
-        tm.tm_min,
-        tm.tm_sec,
-        ms);
-
-    if (threadID)
-    {
-        printf("%s [%s] [tid=%d] %s:%s:%d %s\n",
-            timestamp,
-            levelMap[static_cast<int>(level)],
-            threadID,
-            func, basename(file), line,
-            formatted);
-    }
-    else
-    {
-        printf("%s [%s] %s:%s:%d %s\n",
-            timestamp,
-            levelMap[static_cast<int>(level)],
-            func, basename(file), line,
-            formatted);
-    }
+    // What is queued happened before, keep the order
+    if (gLogWriter.running())
+        gLogWriter.flush();
 
+    write_line(spec, level, func, file, line, threadID, formatted);
     fflush(stdout);
 
     if (FATAL_LEVEL == level)
@@ -19,6 +19,19 @@
 #ifndef RDK_AT_LOGGER_H
 #define RDK_AT_LOGGER_H
 
+#include <stdint.h>
+
+#include <atomic>
+
+/**
+ * Most detailed level compiled in, statements above it are removed at build
+ * time, arguments included. Defaults to TRACE_LEVEL (5), e.g. build with
+ * LOG_LEVEL=3 to drop VERBOSE & TRACE call sites.
+ */
+#ifndef RDKAT_COMPILE_LOG_LEVEL
+#define RDKAT_COMPILE_LOG_LEVEL 5
+#endif
+
 namespace RDK_AT
 {
 
@@ -36,16 +49,38 @@ enum LogLevel {FATAL_LEVEL = 0, ERROR_LEVEL, WARNING_LEVEL, INFO_LEVEL, VERBOSE_
  */
 void logger_init();
 
+/**
+ * @brief Re-reads the backend's level configuration into the cached level
+ * Called by logger_init(), call again when the log configuration may have changed.
+ */
+void logger_refresh();
+
+/**
+ * Most detailed level the backend currently accepts, cached so that a
+ * disabled statement costs a load and a branch.
+ */
+extern std::atomic<int> gEnabledLogLevel;
+
 /**
  * @brief Checks if logging is enabled for log level
  */
-bool is_log_level_enabled(LogLevel level);
+inline bool is_log_level_enabled(LogLevel level)
+{
+    return level <= RDKAT_COMPILE_LOG_LEVEL
+        && level <= gEnabledLogLevel.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Number of messages dropped because the asynchronous log ring was full
+ */
+uint64_t log_dropped_count();
 
 /**
  * @brief Log a message
  * The function is defined by logging backend.
  * Currently 2 variants are supported: rdk_logger (USE_RDK_LOGGER),
- *                                     stdout(default)
+ *                                     stdout(default, written asynchronously)
+ * A threadID of 0 is replaced with the caller's thread id by the stdout backend.
  */
 void log(LogLevel level,
     const char* func,
@@ -54,11 +89,14 @@ void log(LogLevel level,
     int threadID,
     const char* format, ...);
 
-#define _LOG(LEVEL, FORMAT, ...)          \
-    RDK_AT::log(LEVEL,                       \
-         __func__, __FILE__, __LINE__, 0, \
-         FORMAT,                          \
-         ##__VA_ARGS__)
+#define _LOG(LEVEL, FORMAT, ...)                  \
+    do {                                          \
+        if (RDK_AT::is_log_level_enabled(LEVEL))  \
+            RDK_AT::log(LEVEL,                    \
+                 __func__, __FILE__, __LINE__, 0, \
+                 FORMAT,                          \
+                 ##__VA_ARGS__);                  \
+    } while (0)
 
 #define RDKLOG_TRACE(FMT, ...)   _LOG(RDK_AT::TRACE_LEVEL, FMT, ##__VA_ARGS__)
 #define RDKLOG_VERBOSE(FMT, ...) _LOG(RDK_AT::VERBOSE_LEVEL, FMT, ##__VA_ARGS__)
@@ -0,0 +1,88 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_MPSC_QUEUE_H
+#define RDK_AT_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Unbounded lock-free multi producer / single consumer FIFO.
+ *
+ * Intrusive list with a stub node (D. Vyukov): push() is one atomic exchange
+ * and never waits on the consumer or on other producers. pop() may report
+ * the queue empty while a push is half way through, the item shows up on a
+ * later pop(), so the consumer must be woken up after each push.
+ *
+ * push() from any thread, pop() from one thread at a time.
+ */
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue() : m_head(new Node()), m_tail(m_head.load(std::memory_order_relaxed)) { }
+
+    ~MpscQueue()
+    {
+        T value;
+        while(pop(value)) { }
+        delete m_tail;
+    }
+
+    void push(T &&value)
+    {
+        Node *node = new Node();
+        node->value = std::move(value);
+        Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool pop(T &value)
+    {
+        Node *tail = m_tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if(!next)
+            return false;
+
+        // next becomes the stub, its value is moved out
+        value = std::move(next->value);
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+private:
+    MpscQueue(const MpscQueue &);
+    MpscQueue& operator=(const MpscQueue &);
+
+    struct Node {
+        Node() : next(nullptr) { }
+        std::atomic<Node*> next;
+        T value;
+    };
+
+    std::atomic<Node*> m_head; // last pushed, producers
+    Node *m_tail;              // stub, consumer
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_MPSC_QUEUE_H
@@ -19,8 +19,16 @@
 
 #include "rdkat.h"
 #include "logger.h"
-
-#include "TTSClient.h"
+#include "listener_set.h"
+#include "signal_cache.h"
+#include "event_types.h"
+#include "view_context.h"
+#include "context_router.h"
+#include "role_descriptor.h"
+#include "event_record.h"
+#include "event_trace.h"
+#include "statistics.h"
+#include "event_filter.h"
 
 #include <glib.h>
 #include <stdio.h>
@@ -30,27 +38,19 @@
 #include <unistd.h>
 #include <atk/atk.h>
 
-#include <sstream>
-
-#define EVENT_OBJECT   "rdkat.Event.Object"
-#define EVENT_WINDOW   "rdkat.Event.Window"
-#define EVENT_DOCUMENT "rdkat.Event.Document"
-#define EVENT_FOCUS    "rdkat.Event.Focus"
+#include <mutex>
 
 #define PROPERTY_CHANGE "PropertyChange"
 #define STATE_CHANGED   "state-changed"
 
+// Single definition, signal lookups are cached by the address of the name
+static const char TEXT_CHANGED[] = "text-changed";
+
 using namespace std;
 
 namespace RDK_AT {
 
-class RDKAt : public TTS::TTSConnectionCallback, public TTS::TTSSessionCallback {
-    enum val_type {
-        STRING,
-        INT,
-        POINTER
-    };
-
+class RDKAt {
 public:
     static RDKAt& Instance() {
         static RDKAt rdk_at;
@@ -58,98 +58,93 @@ public:
     }
 
     ~RDKAt() {
-        if(m_ttsClient) {
-            delete m_ttsClient;
-            m_ttsClient = NULL;
-        }
         uninitialize();
     }
 
     void initialize(void);
-    void enableProcessing(bool enable);
-    void setVolumeControlCallback(MediaVolumeControlCallback cb, void *data);
+    ViewContext* createContext(AtkObject *root);
+    void destroyContext(ViewContext *context);
+    void enableProcessing(ViewContext *context, bool enable);
+    void setVolumeControlCallback(ViewContext *context, MediaVolumeControlCallback cb, void *data);
     void uninitialize(void);
+    void statistics(std::string &out);
 
-    void ensureTTSConnection();
-    void createOrDestroySession();
-    bool processingEnabled() { return m_process; }
-
-    void resetMediaVolume() {
-        if(RDKAt::Instance().m_mediaVolumeUpdated && RDKAt::Instance().m_mediaVolumeControlCB) {
-            RDKAt::Instance().m_mediaVolumeControlCB(RDKAt::Instance().m_mediaVolumeControlCBData, 1);
-            RDKAt::Instance().m_mediaVolumeUpdated = false;
-        }
-    }
-
-    // TTS Session Callbacks
-    virtual void onTTSServerConnected() {
-        RDKLOG_INFO("Connection to TTSManager got established");
-        // Handle TTSEngine crash & reconnection
-        if(processingEnabled())
-            m_shouldCreateSession = true;
-    }
-
-    virtual void onTTSServerClosed() {
-        RDKLOG_ERROR("Connection to TTSManager got closed!!!");
-        m_sessionId = 0;
-        m_shouldCreateSession = false;
-    }
-
-    virtual void onTTSStateChanged(bool enabled) {
-        m_ttsEnabled = enabled;
-        RDKLOG_INFO("TTS is %s", m_ttsEnabled ? "enabled" : "disabled");
-    }
-
-    virtual void onTTSSessionCreated(uint32_t, uint32_t) {};
-    virtual void onResourceAcquired(uint32_t, uint32_t) {};
-    virtual void onResourceReleased(uint32_t, uint32_t) {};
-
-    virtual void onSpeechStart(uint32_t appid, uint32_t sessionid, TTS::SpeechData &data) {
-        RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d, text=%s", appid, sessionid, data.id, data.text.c_str());
-    }
-
-    virtual void onNetworkError(uint32_t appId, uint32_t sessionId, uint32_t speechId) {
-        RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d", appId, sessionId, speechId);
-        resetMediaVolume();
-    }
-
-    virtual void onPlaybackError(uint32_t appId, uint32_t sessionId, uint32_t speechId) {
-        RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d", appId, sessionId, speechId);
-        resetMediaVolume();
-    }
-
-    virtual void onSpeechComplete(uint32_t appid, uint32_t sessionid, TTS::SpeechData &data) {
-        RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d, text=%s", appid, sessionid, data.id, data.text.c_str());
-        resetMediaVolume();
-    }
-
-    MediaVolumeControlCallback m_mediaVolumeControlCB;
-    void *m_mediaVolumeControlCBData;
+    ViewContext* defaultContext() { return &m_defaultContext; }
 
 private:
     RDKAt() :
-    m_mediaVolumeControlCB(NULL),
-    m_mediaVolumeControlCBData(NULL),
-    m_listenerIds(NULL),
+    m_defaultContext(NULL),
+    m_router(&m_defaultContext),
+    m_listenerSet(NULL),
+    m_mainContext(NULL),
     m_focusTrackerId(0),
     m_keyEventListenerId(0),
     m_initialized(false),
-    m_process(false),
-    m_ttsEnabled(false),
-    m_mediaVolumeUpdated(false),
-    m_appId(this),
-    m_sessionId(0),
-    m_shouldCreateSession(false),
-    m_ttsClient(NULL),
-    m_connectionAttempt(0) { }
-    RDKAt(RDKAt &) {}
-
-    inline static void printEventInfo(const std::string &klass, const std::string &major, const std::string &minor,
-            guint32 d1, guint32 d2, const void *val, int type);
-    inline static void printAccessibilityInfo(std::string &name, std::string &desc, std::string &role);
-    static void HandleEvent(AtkObject *obj, std::string klass,
-            const gchar* major_raw, const gchar* minor_raw, guint32 d1, guint32 d2, const void *val, int type);
+    m_debugging(false),
+    m_utteranceDepth(0) { }
+    RDKAt(RDKAt &);
+
+    // Composing an utterance calls into ATK, which may emit signals that re-enter
+    // HandleEvent on this thread: each nesting level composes into its own buffer
+    class UtteranceScope {
+    public:
+        explicit UtteranceScope(RDKAt &self) : m_self(self) {
+            m_text = self.m_utteranceDepth < kUtteranceDepth ? &self.m_utterances[self.m_utteranceDepth] : &m_overflow;
+            self.m_utteranceDepth++;
+            m_text->clear();
+        }
+        ~UtteranceScope() { m_self.m_utteranceDepth--; }
+        std::string& text() { return *m_text; }
 
+    private:
+        UtteranceScope(const UtteranceScope &);
+        UtteranceScope& operator=(const UtteranceScope &);
+
+        RDKAt &m_self;
+        std::string *m_text;
+        std::string m_overflow; // deeper than kUtteranceDepth
+    };
+    static const unsigned kUtteranceDepth = 4;
+
+    // Called on the TTS client thread
+    static void TTSStateChanged(bool enabled, void *data);
+
+    inline static void printEventInfo(const EventRecord &event);
+    inline static void printAccessibilityInfo(const gchar *name, const gchar *desc, AtkRole role);
+    static void HandleEvent(const EventRecord &event);
+    static ListenerStats& listenerStats(ListenerStat listener) { return Instance().m_listenerStats[listener]; }
+
+    // Composes the utterance for an event, returns true if it should be spoken
+    typedef bool (*EventHandler)(ViewContext &context, const EventRecord &event, std::string &text);
+    static EventHandler s_handlers[EVENT_MAJOR_COUNT][EVENT_MINOR_COUNT];
+    // What still has to run for events the filter policy keeps from being spoken
+    static EventHandler s_invalidators[EVENT_MAJOR_COUNT][EVENT_MINOR_COUNT];
+    static void buildDispatchTable();
+    static void setHandler(EventMajor major, EventMinor minor, EventHandler handler);
+    static void setHandler(EventMajor major, EventHandler handler);
+    static void setInvalidator(EventMajor major, EventMinor minor, EventHandler handler);
+    static void setInvalidator(EventMajor major, EventHandler handler);
+
+    static bool FocusedHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static void FocusSettled(AtkObject *obj, uint64_t eventNs, void *data);
+    static void LiveRegionUpdated(AtkObject *region, const std::string &text, SpeechPriority priority,
+            uint64_t eventNs, void *data);
+    static void ComposeFocusText(ViewContext &context, AtkObject *obj, std::string &text);
+    static void Speak(ViewContext &context, AtkObject *obj, const std::string &text, SpeechPriority priority, uint64_t eventNs,
+            bool dedupe = true);
+    static bool CheckedHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool LoadCompleteHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool InvalidateHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool NameChangedHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool TableChangedHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool TextInsertHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool TextRemoveHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool CaretMovedHandler(ViewContext &context, const EventRecord &event, std::string &text);
+    static bool ChildAddedHandler(ViewContext &context, const EventRecord &event, std::string &text);
+
+    static bool Accepted(EventMajor major, EventMinor minor, AtkObject *obj);
+    static bool Rejected(EventMajor major, EventMinor minor, AtkObject *obj);
+    static bool Rejected(EventMajor major, GQuark detail, const GValue *params);
     static gint KeyListener(AtkKeyEventStruct *event, gpointer data);
     static void FocusTracker(AtkObject *accObj);
     static gboolean PropertyEventListener(GSignalInvocationHint *signal,
@@ -177,21 +172,29 @@ private:
     static gboolean GenericEventListener(GSignalInvocationHint *signal,
             guint param_count, const GValue *params, gpointer data);
 
-    guint addSignalListener(GSignalEmissionHook listener, const char *signal_name);
-
-    GArray *m_listenerIds;
+    void updateListeners();
+    static gboolean UpdateListenersCallback(gpointer data);
+
+    static const ListenerEntry s_listeners[];
+
+    ViewContext m_defaultContext;
+    ContextRouter m_router;
+    std::mutex m_contextsMutex; // held to add / remove contexts and by statistics()
+    std::string m_utterances[kUtteranceDepth]; // composition buffers, reused across events
+    EventArena m_arena;
+    EventTrace m_trace;
+    ListenerStats m_listenerStats[LISTENER_STAT_COUNT];
+    LatencyHistogram m_handleEventTime;
+    LatencyHistogram m_focusSettledTime;
+    EventFilter m_filter;
+    ListenerSet *m_listenerSet;
+    GMainContext *m_mainContext;
     gint m_focusTrackerId;
     gint m_keyEventListenerId;
 
     bool m_initialized;
-    bool m_process;
-    bool m_ttsEnabled;
-    bool m_mediaVolumeUpdated;
-    uint32_t m_appId;
-    uint32_t m_sessionId;
-    bool m_shouldCreateSession;
-    TTS::TTSClient *m_ttsClient;
-    uint8_t m_connectionAttempt;
+    bool m_debugging;
+    unsigned m_utteranceDepth;
 };
 
 gint RDKAt::KeyListener(AtkKeyEventStruct *event, gpointer data)
@@ -200,281 +203,425 @@ gint RDKAt::KeyListener(AtkKeyEventStruct *event, gpointer data)
     return 0;
 }
 
-inline std::string checkNullAndReturnStr(char* temp){
-    return (temp != NULL)? temp : std::string();
+inline void getAccessibilityInfo(AtkObject *obj, const gchar *&name, const gchar *&desc, AtkRole &role) {
+    name = atk_object_get_name(obj);
+    desc = atk_object_get_description(obj);
+    role = atk_object_get_role(obj);
+    if(!name)
+        name = "";
+    if(!desc)
+        desc = "";
 }
 
-inline void getAccessibilityInfo(AtkObject *obj, std::string &name, std::string &desc, std::string &role) {
-    name = checkNullAndReturnStr(atk_object_get_name(obj));
-    desc = checkNullAndReturnStr(atk_object_get_description(obj));
-    role = checkNullAndReturnStr(atk_role_get_name(atk_object_get_role(obj)));
-}
-
-#define PRINT_HELPER(ss, c, key, value) do {\
-     if(!value.empty()) { \
-         ss << (c ? ", " : "") << key << "=\"" << value << "\""; \
-         c = true; \
-     } \
- } while(0)
+inline void RDKAt::printEventInfo(const EventRecord &event) {
+    if (!is_log_level_enabled(RDK_AT::VERBOSE_LEVEL))
+        return;
 
-inline static void RDKAt::printEventInfo(const std::string &klass, const std::string &major, const std::string &minor,
-        guint32 d1, guint32 d2, const void *val, int type) {
+    EventArena &arena = RDKAt::Instance().m_arena;
+
+    const char *minor = event.minorName ? event.minorName : "";
+    if(event.minorPrefix)
+        minor = *minor ? arena.printf("%s:%s", event.minorPrefix, minor) : event.minorPrefix;
+
+    const char *data = NULL;
+    if(event.valueType == EVENT_VALUE_POINTER)
+        data = arena.printf("%p", event.value);
+    else if(event.valueType == EVENT_VALUE_INT)
+        data = arena.printf("%d", GPOINTER_TO_INT(event.value));
+    else if(event.valueType == EVENT_VALUE_STRING && event.value)
+        data = (const char *)event.value;
+
+    RDKLOG_VERBOSE("class=\"%s\", major=\"%s\"%s%s%s, d1=\"%d\", d2=\"%d\"%s%s%s",
+        eventClassName(event.klass), event.majorName ? event.majorName : "",
+        *minor ? ", minor=\"" : "", minor, *minor ? "\"" : "",
+        event.d1, event.d2,
+        data ? ", data=\"" : "", data ? data : "", data ? "\"" : "");
+}
 
+inline void RDKAt::printAccessibilityInfo(const gchar *name, const gchar *desc, AtkRole role) {
     if (!is_log_level_enabled(RDK_AT::VERBOSE_LEVEL))
         return;
 
-    bool c = false;
-    std::stringstream ss;
-
-    PRINT_HELPER(ss, c, "class", klass);
-    PRINT_HELPER(ss, c, "major", major);
-    PRINT_HELPER(ss, c, "minor", minor);
-    PRINT_HELPER(ss, c, "d1", std::to_string(d1));
-    PRINT_HELPER(ss, c, "d2", std::to_string(d2));
-
-    if(type == POINTER) {
-        char buff[16] = {0};
-        sprintf(buff, "%p", val);
-        PRINT_HELPER(ss, c, "data", std::string(buff));
-    } else if(type == INT) {
-        PRINT_HELPER(ss, c, "data", std::to_string((int)val));
-    } else if(type == STRING) {
-        PRINT_HELPER(ss, c, "data", std::string((char *)val));
-    }
+    const gchar *roleName = atk_role_get_name(role);
+    RDKLOG_VERBOSE("name=\"%s\", desc=\"%s\", role=\"%s\"", name, desc, roleName ? roleName : "");
+}
 
-    RDKLOG_VERBOSE("%s", ss.str().c_str());
+RDKAt::EventHandler RDKAt::s_handlers[EVENT_MAJOR_COUNT][EVENT_MINOR_COUNT];
+
+void RDKAt::setHandler(EventMajor major, EventMinor minor, EventHandler handler)
+{
+    s_handlers[major][minor] = handler;
 }
 
-inline void RDKAt::printAccessibilityInfo(std::string &name, std::string &desc, std::string &role) {
-    if (!is_log_level_enabled(RDK_AT::VERBOSE_LEVEL))
+void RDKAt::setHandler(EventMajor major, EventHandler handler)
+{
+    for(int minor = 0; minor < EVENT_MINOR_COUNT; minor++)
+        s_handlers[major][minor] = handler;
+}
+
+RDKAt::EventHandler RDKAt::s_invalidators[EVENT_MAJOR_COUNT][EVENT_MINOR_COUNT];
+
+void RDKAt::setInvalidator(EventMajor major, EventMinor minor, EventHandler handler)
+{
+    s_invalidators[major][minor] = handler;
+}
+
+void RDKAt::setInvalidator(EventMajor major, EventHandler handler)
+{
+    for(int minor = 0; minor < EVENT_MINOR_COUNT; minor++)
+        s_invalidators[major][minor] = handler;
+}
+
+void RDKAt::buildDispatchTable()
+{
+    memset(s_handlers, 0, sizeof(s_handlers));
+    memset(s_invalidators, 0, sizeof(s_invalidators));
+
+    setHandler(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_FOCUSED, FocusedHandler);
+    setHandler(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_CHECKED, CheckedHandler);
+    setHandler(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_PRESSED, InvalidateHandler);
+    setHandler(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_EXPANDED, InvalidateHandler);
+    setHandler(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_SELECTED, InvalidateHandler);
+    setHandler(EVENT_MAJOR_LOAD_COMPLETE, LoadCompleteHandler);
+
+    setHandler(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_ACCESSIBLE_NAME, NameChangedHandler);
+    setHandler(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_ACCESSIBLE_DESCRIPTION, InvalidateHandler);
+    setHandler(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_ACCESSIBLE_ROLE, InvalidateHandler);
+
+    setHandler(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_TABLE_CAPTION_OBJECT, TableChangedHandler);
+    setHandler(EVENT_MAJOR_ROW_INSERTED, TableChangedHandler);
+    setHandler(EVENT_MAJOR_ROW_REORDERED, TableChangedHandler);
+    setHandler(EVENT_MAJOR_ROW_DELETED, TableChangedHandler);
+    setHandler(EVENT_MAJOR_COLUMN_INSERTED, TableChangedHandler);
+    setHandler(EVENT_MAJOR_COLUMN_REORDERED, TableChangedHandler);
+    setHandler(EVENT_MAJOR_COLUMN_DELETED, TableChangedHandler);
+    setHandler(EVENT_MAJOR_MODEL_CHANGED, TableChangedHandler);
+
+    setHandler(EVENT_MAJOR_TEXT_INSERT, TextInsertHandler);
+    setHandler(EVENT_MAJOR_TEXT_REMOVE, TextRemoveHandler);
+    setHandler(EVENT_MAJOR_TEXT_CARET_MOVED, CaretMovedHandler);
+    setHandler(EVENT_MAJOR_CHILDREN_CHANGED, EVENT_MINOR_CHILD_ADD, ChildAddedHandler);
+    setHandler(EVENT_MAJOR_CHILDREN_CHANGED, EVENT_MINOR_CHILD_REMOVE, TableChangedHandler);
+
+    // Cached utterances and table context go stale without these, see EventFilter
+    setInvalidator(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_CHECKED, InvalidateHandler);
+    setInvalidator(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_PRESSED, InvalidateHandler);
+    setInvalidator(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_EXPANDED, InvalidateHandler);
+    setInvalidator(EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_SELECTED, InvalidateHandler);
+    setInvalidator(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_ACCESSIBLE_NAME, NameChangedHandler);
+    setInvalidator(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_ACCESSIBLE_DESCRIPTION, InvalidateHandler);
+    setInvalidator(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_ACCESSIBLE_ROLE, InvalidateHandler);
+    setInvalidator(EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_TABLE_CAPTION_OBJECT, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_ROW_INSERTED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_ROW_REORDERED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_ROW_DELETED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_COLUMN_INSERTED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_COLUMN_REORDERED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_COLUMN_DELETED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_MODEL_CHANGED, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_CHILDREN_CHANGED, EVENT_MINOR_CHILD_ADD, TableChangedHandler);
+    setInvalidator(EVENT_MAJOR_CHILDREN_CHANGED, EVENT_MINOR_CHILD_REMOVE, TableChangedHandler);
+}
+
+bool RDKAt::FocusedHandler(ViewContext &context, const EventRecord &event, std::string &)
+{
+    // Accessibility info is fetched once focus settles, see FocusSettled()
+    if(event.d1 == 1)
+        context.focusChanged(event.object, ListenerTimer::entryTime());
+    return false;
+}
+
+// Password fields are left out, what is typed there isn't to be said
+static bool isEditableText(AtkObject *obj)
+{
+    if(!ATK_IS_TEXT(obj) || atk_object_get_role(obj) == ATK_ROLE_PASSWORD_TEXT)
+        return false;
+
+    AtkStateSet *states = atk_object_ref_state_set(obj);
+    bool editable = atk_state_set_contains_state(states, ATK_STATE_EDITABLE);
+    g_object_unref(states);
+    return editable;
+}
+
+void RDKAt::FocusSettled(AtkObject *obj, uint64_t eventNs, void *data)
+{
+    RDKAt &self = RDKAt::Instance();
+    ViewContext &context = *static_cast<ViewContext*>(data);
+    HistogramTimer timer(self.m_focusSettledTime);
+    context.focusSettled(obj);
+
+    if(!context.processingEnabled() || (!context.speech().ttsEnabled() && !self.m_debugging))
         return;
 
-    bool c = false;
-    std::stringstream ss;
+    // Typing is echoed from a copy of the field's text, fetched once here
+    context.textMirror().track(isEditableText(obj) ? obj : NULL);
 
-    PRINT_HELPER(ss, c, "name", name);
-    PRINT_HELPER(ss, c, "desc", desc);
-    PRINT_HELPER(ss, c, "role", role);
+    UtteranceScope utterance(self);
+    std::string &text = utterance.text();
+    ComposeFocusText(context, obj, text);
+    Speak(context, obj, text, SPEECH_PRIORITY_FOCUS, eventNs);
+}
 
-    RDKLOG_VERBOSE("%s", ss.str().c_str());
+void RDKAt::LiveRegionUpdated(AtkObject *region, const std::string &text, SpeechPriority priority,
+        uint64_t eventNs, void *data)
+{
+    RDKAt &self = RDKAt::Instance();
+    ViewContext &context = *static_cast<ViewContext*>(data);
+    if(!context.processingEnabled() || (!context.speech().ttsEnabled() && !self.m_debugging))
+        return;
+
+    RDKLOG_VERBOSE("Live region %p updated: \"%s\"", region, text.c_str());
+    Speak(context, region, text, priority, eventNs, false);
 }
 
-std::string getCellDescription(AtkObject *cell, AtkRole role) {
-    static AtkObject *pCell = NULL;
-    static AtkTable *pTableObj = NULL;
-    static AtkObject *pRowObj = NULL;
+void RDKAt::ComposeFocusText(ViewContext &context, AtkObject *obj, std::string &text)
+{
+    UtteranceCache &cache = context.utteranceCache();
+    const std::string *cached = cache.lookup(obj);
+    if(cached) {
+        text = *cached;
+        RDKLOG_VERBOSE("Utterance cache hit, hits=%llu, misses=%llu",
+            (unsigned long long)cache.hits(), (unsigned long long)cache.misses());
+    } else {
+        const gchar *name, *desc;
+        AtkRole role;
+        getAccessibilityInfo(obj, name, desc, role);
+        printAccessibilityInfo(name, desc, role);
 
-    // On focusing a non-cell element, forget previous cell details
-    if(role != ATK_ROLE_TABLE_CELL) {
-        pCell = NULL;
-        pTableObj = NULL;
-        pRowObj = NULL;
-        return string();
-    }
+        text.assign(name);
+        if(!text.empty()) {
+            const RoleDescriptor &rd = roleDescriptor(role);
+            uint8_t relevant;
+            uint8_t active = roleStates(obj, rd, relevant);
+            appendRoleText(text, rd, relevant, active);
 
-    AtkObject *obj = cell;
-    AtkTable *tableObj = NULL;
-    AtkObject *rowObj = NULL;
-
-    // Find Table Object
-    while(obj) {
-        obj = atk_object_get_parent(obj);
-        if(!obj)
-            break;
-
-        role = atk_object_get_role(obj);
-        if(role == ATK_ROLE_TABLE) {
-            tableObj = ATK_TABLE(obj);
-            break;
-        } else if(role == ATK_ROLE_TABLE_ROW) {
-            rowObj = obj;
+            if(*desc && strcmp(name, desc) != 0) {
+                text += ". ";
+                text += desc;
+            }
         }
+
+        cache.insert(obj, text);
     }
 
-    // Retrieve Table Caption
-    std::string caption;
-    if(tableObj) {
-        AtkObject *captionObj = atk_table_get_caption(tableObj);
-        if(captionObj && (cell == pCell || tableObj != pTableObj))
-            caption = checkNullAndReturnStr(atk_object_get_name(captionObj));
+    // Table context depends on where focus comes from, so it is never cached
+    std::string cellDesc, cellPosition;
+    context.tableContext().describe(obj, atk_object_get_role(obj), cellDesc, cellPosition);
+    if(!cellDesc.empty()) {
+        RDKLOG_VERBOSE("Table Cell Description = \"%s\"", cellDesc.c_str());
+        text = cellDesc + text;
     }
+    if(!cellPosition.empty())
+        text += (text.empty() ? "" : ". ") + cellPosition;
+}
 
-    // Retrieve Row Heading
-    // Note : this is not the not Row Header element, but the accessible name of Row element
-    std::string rowHeader;
-    if(rowObj && (cell == pCell || rowObj != pRowObj)) {
-       rowHeader = checkNullAndReturnStr(atk_object_get_name(rowObj));
+bool RDKAt::CheckedHandler(ViewContext &context, const EventRecord &event, std::string &text)
+{
+    AtkObject *obj = event.object;
+    context.utteranceCache().invalidate(obj);
+
+    const gchar *name, *desc;
+    AtkRole role;
+    getAccessibilityInfo(obj, name, desc, role);
+    printAccessibilityInfo(name, desc, role);
+
+    text.assign(name);
+    const RoleDescriptor &rd = roleDescriptor(role);
+    const uint8_t changed = rd.states & (ROLE_STATE_CHECKED | ROLE_STATE_PRESSED);
+    if(!text.empty() && changed) {
+        // Only announce the state which changed, using the signal's value
+        appendRoleText(text, rd, changed, event.d1 ? changed : ROLE_STATE_NONE);
     }
+    return true;
+}
+
+bool RDKAt::LoadCompleteHandler(ViewContext &, const EventRecord &event, std::string &text)
+{
+    AtkObject *obj = event.object;
+    AtkRole atkrole = atk_object_get_role(obj);
+    if(atkrole == ATK_ROLE_DOCUMENT_FRAME)
+        return false;
+
+    const gchar *name, *desc;
+    AtkRole role;
+    getAccessibilityInfo(obj, name, desc, role);
+    printAccessibilityInfo(name, desc, role);
+
+    if(!*name)
+        return false;
+
+    text.assign(name);
+    text += " is loaded";
+    return true;
+}
 
-    // Remember Table information
-    pTableObj = tableObj;
-    pRowObj = rowObj;
-    pCell = cell;
+bool RDKAt::InvalidateHandler(ViewContext &context, const EventRecord &event, std::string &)
+{
+    context.utteranceCache().invalidate(event.object);
+    return false;
+}
 
-    std::string res;
-    if(!caption.empty())
-        res = caption + ". ";
-    if(!rowHeader.empty())
-        res += rowHeader + ". ";
+// Renamed rows and captions are cached by the table context too
+bool RDKAt::NameChangedHandler(ViewContext &context, const EventRecord &event, std::string &)
+{
+    context.utteranceCache().invalidate(event.object);
+    context.tableContext().nameChanged(event.object);
+    return false;
+}
 
-    return res;
+bool RDKAt::TableChangedHandler(ViewContext &context, const EventRecord &event, std::string &)
+{
+    context.tableContext().invalidateTable(event.object);
+    return false;
 }
 
-void RDKAt::ensureTTSConnection()
+// Edits of the focused field are echoed, the others may be live region updates, announced later
+bool RDKAt::TextInsertHandler(ViewContext &context, const EventRecord &event, std::string &text)
 {
-    if(!m_ttsClient) {
-        if(m_connectionAttempt > 0)
-            return;
+    if(event.valueType != EVENT_VALUE_STRING)
+        return false;
 
-        m_connectionAttempt++;
-        m_ttsClient = TTS::TTSClient::create(this);
-    }
+    TextMirror &mirror = context.textMirror();
+    if(mirror.tracks(event.object))
+        return mirror.inserted(event.d1, (const char *)event.value, text);
+
+    context.liveRegions().textInserted(event.object, (const char *)event.value, ListenerTimer::entryTime());
+    return false;
 }
 
-void RDKAt::createOrDestroySession()
+bool RDKAt::TextRemoveHandler(ViewContext &context, const EventRecord &event, std::string &text)
 {
-    if(!m_ttsClient)
-        return;
+    TextMirror &mirror = context.textMirror();
+    if(mirror.tracks(event.object))
+        return mirror.removed(event.d1, event.d2, text);
 
-    if(processingEnabled()) {
-        if(m_sessionId == 0 && m_shouldCreateSession) {
-            m_sessionId = m_ttsClient->createSession(m_appId, "WPE", this);
-        }
-    } else {
-        if(m_sessionId != 0) {
-            if(m_mediaVolumeControlCBData)
-                m_mediaVolumeControlCB(m_mediaVolumeControlCBData, 1);
+    if(event.valueType == EVENT_VALUE_STRING)
+        context.liveRegions().textRemoved(event.object, (const char *)event.value, ListenerTimer::entryTime());
+    return false;
+}
 
-            m_ttsClient->abort(m_sessionId);
-            m_ttsClient->destroySession(m_sessionId);
-            m_sessionId = 0;
-        }
-    }
-    m_shouldCreateSession = false;
+bool RDKAt::CaretMovedHandler(ViewContext &context, const EventRecord &event, std::string &text)
+{
+    TextMirror &mirror = context.textMirror();
+    if(!mirror.tracks(event.object))
+        return false;
+    return mirror.caretMoved(event.d1, text);
+}
+
+bool RDKAt::ChildAddedHandler(ViewContext &context, const EventRecord &event, std::string &)
+{
+    context.tableContext().invalidateTable(event.object);
+    AtkObject *child = event.valueType == EVENT_VALUE_POINTER ? (AtkObject *)event.value : NULL;
+    context.liveRegions().childAdded(event.object, child, ListenerTimer::entryTime());
+    return false;
+}
+
+static SpeechPriority speechPriority(const EventRecord &event)
+{
+    // Typing & caret echo is about the focused field, the next key press supersedes it
+    if(event.major == EVENT_MAJOR_STATE_CHANGED || event.major == EVENT_MAJOR_TEXT_INSERT ||
+            event.major == EVENT_MAJOR_TEXT_REMOVE || event.major == EVENT_MAJOR_TEXT_CARET_MOVED)
+        return SPEECH_PRIORITY_STATE;
+    if(event.klass == EVENT_CLASS_DOCUMENT || event.klass == EVENT_CLASS_WINDOW)
+        return SPEECH_PRIORITY_DOCUMENT;
+    return SPEECH_PRIORITY_LIVE;
 }
 
-void RDKAt::HandleEvent(AtkObject *obj, std::string klass,
-        const gchar* major_raw, const gchar* minor_raw,
-        guint32 d1, guint32 d2, const void *val, int type)
+void RDKAt::HandleEvent(const EventRecord &event)
 {
+    RDKAt &self = RDKAt::Instance();
+    HistogramTimer timer(self.m_handleEventTime);
+    if(self.m_trace.enabled())
+        self.m_trace.event(event);
+
+    ViewContext &context = *self.m_router.route(event.object);
     static bool logProcessingError = true;
-    if(!RDKAt::Instance().processingEnabled()) {
+    if(!context.processingEnabled()) {
         if(logProcessingError)
             RDKLOG_ERROR("Processing ARIA Accessibility events are not enabled");
         logProcessingError = false;
+        ListenerTimer::dropped();
         return;
     }
     logProcessingError = true;
 
-    const std::string major = major_raw ? major_raw : "";
-    const std::string minor = minor_raw ? minor_raw : "";
-
-    printEventInfo(klass, major, minor, d1, d2, val, type);
-
-    RDKAt::Instance().ensureTTSConnection();
-    RDKAt::Instance().createOrDestroySession();
+    // Whatever gets formatted for this event is released on return
+    EventArenaScope arenaScope(self.m_arena);
+    printEventInfo(event);
 
     // If TTS is not enabled, skip costly dom traversals as part of name & desc retrieval
-    static bool enableDebugging = getenv("ENABLE_RDKAT_DEBUGGING");
     static bool logDebuggingDisabled = true;
-    if(!RDKAt::Instance().m_ttsEnabled) {
-        if(!enableDebugging) {
+    if(!context.speech().ttsEnabled()) {
+        if(!self.m_debugging) {
             if(logDebuggingDisabled)
                 RDKLOG_ERROR("Both TTS & RDK-AT Debugging are disabled, not fetching accessibility info");
             logDebuggingDisabled = false;
+            ListenerTimer::dropped();
             return;
         }
     }
     logDebuggingDisabled = true;
 
-    TTS::SpeechData d;
-    bool speak = false;
-    std::string name, desc, role;
-    static unsigned int counter = 0;
-    if(major == "state-changed") {
-        if(minor == "focused" && d1 == 1) {
-            getAccessibilityInfo(obj, name, desc, role);
-            printAccessibilityInfo(name, desc, role);
-
-            d.text = name;
-            if(!d.text.empty() && (role == "button" || role == "push button")) {
-                d.text += " button";
-            } else if(!d.text.empty() && (role == "check" || role == "check box")) {
-                bool md = false;
-                AtkStateSet *set = atk_object_ref_state_set(obj);
-                md = set ? atk_state_set_contains_state(set, ATK_STATE_CHECKED) : false;
-                d.text += (md ? " check box is checked" : " check box is unchecked");
-            }
-
-            if(!name.empty() && !desc.empty() && name != desc)
-                d.text += (". " + desc);
+    // Filtered out events which invalidate caches only get here to do that
+    bool speakable = !self.m_filter.kept(event.major, event.minor) || Accepted(event.major, event.minor, event.object);
+    EventHandler handler = speakable ? s_handlers[event.major][event.minor] : s_invalidators[event.major][event.minor];
+    if(!handler)
+        return;
 
-            std::string cellDesc = getCellDescription(obj, atk_object_get_role(obj));
-            if(!cellDesc.empty()) {
-                RDKLOG_VERBOSE("Table Cell Description = \"%s\"", cellDesc.c_str());
-                d.text = cellDesc + d.text;
-            }
+    UtteranceScope utterance(self);
+    std::string &text = utterance.text();
+    if(handler(context, event, text)) {
+        // Typing "ll" or moving the caret over the same letter twice must be heard twice
+        bool dedupe = event.major != EVENT_MAJOR_TEXT_INSERT && event.major != EVENT_MAJOR_TEXT_REMOVE &&
+            event.major != EVENT_MAJOR_TEXT_CARET_MOVED;
+        Speak(context, event.object, text, speechPriority(event), ListenerTimer::entryTime(), dedupe);
+    }
+}
 
-            speak = true;
-        } else if(minor == "checked") {
-            getAccessibilityInfo(obj, name, desc, role);
-            printAccessibilityInfo(name, desc, role);
+void RDKAt::Speak(ViewContext &context, AtkObject *obj, const std::string &text, SpeechPriority priority, uint64_t eventNs,
+        bool dedupe)
+{
+    if(context.speak(obj, text, priority, eventNs, dedupe))
+        RDKAt::Instance().m_trace.speak(obj, text.size());
+}
 
-            d.text = name;
-            if(!d.text.empty() && (role == "check" || role == "check box"))
-                d.text += (d1 ? " check box is checked" : " check box is unchecked");
-            speak = true;
-        }
-    } else if(major == "load-complete") {
-        AtkRole atkrole = atk_object_get_role(obj);
-        if(atkrole == ATK_ROLE_DOCUMENT_FRAME)
-              return;
-        getAccessibilityInfo(obj, name, desc, role);
-        printAccessibilityInfo(name, desc, role);
+// Checked first thing by the listeners, before any ATK query is made for the event
+bool RDKAt::Accepted(EventMajor major, EventMinor minor, AtkObject *obj)
+{
+    const EventFilter &filter = Instance().m_filter;
+    return filter.accepts(major, minor) && (!filter.filtersRoles() || filter.acceptsRole(atk_object_get_role(obj)));
+}
 
-        if(!name.empty()) {
-            d.text = std::string(name) + " is loaded";
-            speak = true;
-        }
-    }
+bool RDKAt::Rejected(EventMajor major, EventMinor minor, AtkObject *obj)
+{
+    if(Accepted(major, minor, obj) || Instance().m_filter.kept(major, minor))
+        return false;
+    ListenerTimer::dropped();
+    return true;
+}
 
-    TTS::TTSClient *ttsClient = RDKAt::Instance().m_ttsClient;
-    //it is temporary fix to Skip the duplication Text for YouTubeApp
-    static std::string oldText;
-    static AtkObject *oldObj = NULL;
-    if(speak && !d.text.empty()) {
-        if(d.text == oldText && obj == oldObj) {
-            RDKLOG_VERBOSE("Skipping the duplication Text : \"%s\"", d.text.c_str());
-        } else if(ttsClient) {
-            if(ttsClient->isActiveSession(RDKAt::Instance().m_sessionId)) {
-                if(!RDKAt::Instance().m_mediaVolumeUpdated && RDKAt::Instance().m_mediaVolumeControlCB) {
-                    RDKAt::Instance().m_mediaVolumeControlCB(RDKAt::Instance().m_mediaVolumeControlCBData, 0.25);
-                    RDKAt::Instance().m_mediaVolumeUpdated = true;
-                }
-
-                d.id = ++counter;
-                ttsClient->speak(RDKAt::Instance().m_sessionId, d);
-            } else {
-                RDKLOG_WARNING("Session has not acquired resource to speak");
-            }
-        } else {
-            RDKLOG_INFO("Text to Speak : \"%s\"", d.text.c_str());
-        }
-        oldText = d.text;
-        oldObj = obj;
-    }
+bool RDKAt::Rejected(EventMajor major, GQuark detail, const GValue *params)
+{
+    return Rejected(major, eventMinorFromQuark(detail), ATK_OBJECT(g_value_get_object(&params[0])));
 }
 
 void RDKAt::FocusTracker(AtkObject *accObj)
 {
     RDKLOG_TRACE("RDKAt::FocusTracker()");
-    HandleEvent(accObj, EVENT_FOCUS, "focus", "", 0, 0, 0, INT);
+    ListenerTimer timer(listenerStats(LISTENER_STAT_FOCUS_TRACKER));
+    if(Rejected(EVENT_MAJOR_FOCUS, EVENT_MINOR_NONE, accObj))
+        return;
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_FOCUS, EVENT_MAJOR_FOCUS, EVENT_MINOR_NONE, "focus", NULL);
+    HandleEvent(event);
 }
 
 gboolean RDKAt::PropertyEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::PropertyEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_PROPERTY));
+    if(Rejected(EVENT_MAJOR_PROPERTY_CHANGE, signal->detail, params))
+        return TRUE;
 
     gint i;
     const gchar *s1;
@@ -487,48 +634,69 @@ gboolean RDKAt::PropertyEventListener(GSignalInvocationHint *signal,
     propValues = (AtkPropertyValues *)g_value_get_pointer(&params[1]);
     propName = propValues[0].property_name;
 
-    if(strcmp(propName, "accessible-name") == 0) {
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, EVENT_MAJOR_PROPERTY_CHANGE,
+            eventMinorFromString(propName), PROPERTY_CHANGE, propName);
+
+    // New values are only logged, don't make WebKit compute them otherwise
+    if(!is_log_level_enabled(RDK_AT::VERBOSE_LEVEL)) {
+        HandleEvent(event);
+        return TRUE;
+    }
+
+    switch(event.minor) {
+    case EVENT_MINOR_ACCESSIBLE_NAME:
         s1 = atk_object_get_name(accObj);
         if(s1 != NULL)
-            HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, s1, STRING);
-    } else if(strcmp(propName, "accessible-description") == 0) {
+            HandleEvent(withValue(event, s1, EVENT_VALUE_STRING));
+        break;
+    case EVENT_MINOR_ACCESSIBLE_DESCRIPTION:
         s1 = atk_object_get_description(accObj);
         if(s1 != NULL)
-            HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, s1, STRING);
-    } else if(strcmp(propName, "accessible-parent") == 0) {
+            HandleEvent(withValue(event, s1, EVENT_VALUE_STRING));
+        break;
+    case EVENT_MINOR_ACCESSIBLE_PARENT:
         tObj = atk_object_get_parent(accObj);
         if(tObj != NULL)
-            HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, tObj, POINTER);
-    } else if(strcmp(propName, "accessible-role") == 0) {
+            HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
+        break;
+    case EVENT_MINOR_ACCESSIBLE_ROLE:
         i = atk_object_get_role(accObj);
-        HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, GINT_TO_POINTER(i), INT);
-    } else if(strcmp(propName, "accessible-table-summary") == 0) {
+        HandleEvent(withValue(event, GINT_TO_POINTER(i), EVENT_VALUE_INT));
+        break;
+    case EVENT_MINOR_TABLE_SUMMARY:
         tObj = atk_table_get_summary(ATK_TABLE(accObj));
         if(tObj != NULL)
-            HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, tObj, POINTER);
-    } else if(strcmp(propName, "accessible-table-column-header") == 0) {
+            HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
+        break;
+    case EVENT_MINOR_TABLE_COLUMN_HEADER:
         i = g_value_get_int(&(propValues->new_value));
         tObj = atk_table_get_column_header(ATK_TABLE(accObj), i);
         if(tObj != NULL)
-            HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, tObj, POINTER);
-    } else if(strcmp(propName, "accessible-table-row-header") == 0) {
+            HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
+        break;
+    case EVENT_MINOR_TABLE_ROW_HEADER:
         i = g_value_get_int(&(propValues->new_value));
         tObj = atk_table_get_row_header(ATK_TABLE(accObj), i);
         if(tObj != NULL)
-            HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, tObj, POINTER);
-    } else if(strcmp(propName, "accessible-table-row-description") == 0) {
+            HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
+        break;
+    case EVENT_MINOR_TABLE_ROW_DESCRIPTION:
         i = g_value_get_int(&(propValues->new_value));
         s1 = atk_table_get_row_description(ATK_TABLE(accObj), i);
-        HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, s1, STRING);
-    } else if(strcmp(propName, "accessible-table-column-description") == 0) {
+        HandleEvent(withValue(event, s1, EVENT_VALUE_STRING));
+        break;
+    case EVENT_MINOR_TABLE_COLUMN_DESCRIPTION:
         i = g_value_get_int(&(propValues->new_value));
         s1 = atk_table_get_column_description(ATK_TABLE(accObj), i);
-        HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, s1, STRING);
-    } else if(strcmp(propName, "accessible-table-caption-object") == 0) {
+        HandleEvent(withValue(event, s1, EVENT_VALUE_STRING));
+        break;
+    case EVENT_MINOR_TABLE_CAPTION_OBJECT:
         tObj = atk_table_get_caption(ATK_TABLE(accObj));
-        HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, tObj, POINTER);
-    } else {
-        HandleEvent(accObj, EVENT_OBJECT, PROPERTY_CHANGE, propName, 0, 0, 0, INT);
+        HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
+        break;
+    default:
+        HandleEvent(event);
+        break;
     }
 
     return TRUE;
@@ -538,16 +706,20 @@ gboolean RDKAt::StateEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::StateEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_STATE));
+    if(Rejected(EVENT_MAJOR_STATE_CHANGED, signal->detail, params))
+        return TRUE;
 
     AtkObject *accObj;
     const gchar *propName;
-    guint d1;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
     propName = g_value_get_string(&params[1]);
 
-    d1 = (g_value_get_boolean(&params[2])) ? 1 : 0;
-    HandleEvent(accObj, EVENT_OBJECT, STATE_CHANGED, propName, d1, 0, 0, INT);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, EVENT_MAJOR_STATE_CHANGED,
+            eventMinorFromString(propName), STATE_CHANGED, propName);
+    event.d1 = (g_value_get_boolean(&params[2])) ? 1 : 0;
+    HandleEvent(event);
 
     return TRUE;
 }
@@ -556,17 +728,17 @@ gboolean RDKAt::WindowEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::WindowEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_WINDOW));
 
     AtkObject *accObj;
-    GSignalQuery signalQuery;
-    const gchar *major, *str;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    str = atk_object_get_name(accObj);
-    HandleEvent(accObj, EVENT_WINDOW, major, "", 0, 0, str, STRING);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_WINDOW, info.major, EVENT_MINOR_NONE, info.name, NULL);
+    HandleEvent(withValue(event, atk_object_get_name(accObj), EVENT_VALUE_STRING));
 
     return TRUE;
 }
@@ -575,17 +747,17 @@ gboolean RDKAt::DocumentEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::DocumentEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_DOCUMENT));
 
     AtkObject *accObj;
-    GSignalQuery signalQuery;
-    const gchar *major, *str;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    str = atk_object_get_name(accObj);
-    HandleEvent(accObj, EVENT_DOCUMENT, major, "", 0, 0, str, STRING);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_DOCUMENT, info.major, EVENT_MINOR_NONE, info.name, NULL);
+    HandleEvent(withValue(event, atk_object_get_name(accObj), EVENT_VALUE_STRING));
 
     return TRUE;
 }
@@ -594,20 +766,21 @@ gboolean RDKAt::BoundsEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::BoundsEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_BOUNDS));
 
     AtkObject *accObj;
     AtkRectangle *atk_rect;
-    GSignalQuery signalQuery;
-    const gchar *major;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
 
     if(G_VALUE_HOLDS_BOXED(params + 1)) {
         atk_rect = (AtkRectangle*)g_value_get_boxed(params + 1);
-        HandleEvent(accObj, EVENT_OBJECT, major, "", 0, 0, atk_rect, POINTER);
+        EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, info.major, EVENT_MINOR_NONE, info.name, NULL);
+        HandleEvent(withValue(event, atk_rect, EVENT_VALUE_POINTER));
     }
     return TRUE;
 }
@@ -616,23 +789,22 @@ gboolean RDKAt::ActiveDescendantEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::ActiveDescendantEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_ACTIVE_DESCENDANT));
 
     AtkObject *accObj;
     AtkObject *childObj;
-    GSignalQuery signalQuery;
-    const gchar *major;
-    gint d1;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
     childObj = ATK_OBJECT(g_value_get_pointer(&params[1]));
     g_return_val_if_fail(ATK_IS_OBJECT(childObj), TRUE);
 
-    d1 = atk_object_get_index_in_parent(childObj);
-
-    HandleEvent(accObj, EVENT_OBJECT, major, "", d1, 0, childObj, POINTER);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, info.major, EVENT_MINOR_NONE, info.name, NULL);
+    event.d1 = atk_object_get_index_in_parent(childObj);
+    HandleEvent(withValue(event, childObj, EVENT_VALUE_POINTER));
     return TRUE;
 }
 
@@ -640,22 +812,22 @@ gboolean RDKAt::LinkSelectedEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::LinkSelectedEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_LINK_SELECTED));
 
     AtkObject *accObj;
-    GSignalQuery signalQuery;
-    const gchar *major, *minor;
-    gint d1 = 0;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    minor = g_quark_to_string(signal->detail);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, info.major,
+            eventMinorFromQuark(signal->detail), info.name, g_quark_to_string(signal->detail));
 
     if(G_VALUE_TYPE(&params[1]) == G_TYPE_INT)
-        d1 = g_value_get_int(&params[1]);
+        event.d1 = g_value_get_int(&params[1]);
 
-    HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, 0, 0, INT);
+    HandleEvent(event);
     return TRUE;
 }
 
@@ -663,29 +835,26 @@ gboolean RDKAt::TextChangedEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::TextChangedEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_TEXT_CHANGED));
 
     AtkObject *accObj;
-    GSignalQuery signalQuery;
-    const gchar *major, *minor;
-    gchar *selected;
-    gint d1 = 0, d2 = 0;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    minor = g_quark_to_string(signal->detail);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, info.major,
+            eventMinorFromQuark(signal->detail), info.name, g_quark_to_string(signal->detail));
 
     if(G_VALUE_TYPE(&params[1]) == G_TYPE_INT)
-        d1 = g_value_get_int(&params[1]);
+        event.d1 = g_value_get_int(&params[1]);
 
     if(G_VALUE_TYPE(&params[2]) == G_TYPE_INT)
-        d2 = g_value_get_int(&params[2]);
-
-    selected = atk_text_get_text(ATK_TEXT(accObj), d1, d1 + d2);
+        event.d2 = g_value_get_int(&params[2]);
 
-    HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, selected, STRING);
-    g_free(selected);
+    // The changed text is logged along with text-insert / text-remove, not fetched again here
+    HandleEvent(event);
 
     return TRUE;
 }
@@ -694,37 +863,30 @@ gboolean RDKAt::TextInsertEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::TextInsertEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_TEXT_INSERT));
+    if(Rejected(EVENT_MAJOR_TEXT_INSERT, EVENT_MINOR_TEXT_INSERT, ATK_OBJECT(g_value_get_object(&params[0]))))
+        return TRUE;
 
     AtkObject *accObj;
     guint text_changed_signal_id;
-    GSignalQuery signalQuery;
-    const gchar *major = NULL;
-    const gchar *minor_raw = NULL, *text = NULL;
-    gchar *minor;
-    gint d1 = 0, d2 = 0;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    text_changed_signal_id = g_signal_lookup("text-changed", G_OBJECT_TYPE(accObj));
-    g_signal_query(text_changed_signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    text_changed_signal_id = SignalCache::Instance().lookup(TEXT_CHANGED, G_OBJECT_TYPE(accObj));
 
-    minor_raw = g_quark_to_string(signal->detail);
-    if(minor_raw)
-        minor = g_strconcat("insert:", minor_raw, NULL);
-    else
-        minor = g_strdup("insert");
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, EVENT_MAJOR_TEXT_INSERT, EVENT_MINOR_TEXT_INSERT,
+            SignalCache::Instance().name(text_changed_signal_id), g_quark_to_string(signal->detail));
+    event.minorPrefix = "insert";
 
     if(G_VALUE_TYPE(&params[1]) == G_TYPE_INT)
-        d1 = g_value_get_int(&params[1]);
+        event.d1 = g_value_get_int(&params[1]);
 
     if(G_VALUE_TYPE(&params[2]) == G_TYPE_INT)
-        d2 = g_value_get_int(&params[2]);
+        event.d2 = g_value_get_int(&params[2]);
 
     if(G_VALUE_TYPE(&params[3]) == G_TYPE_STRING)
-        text = g_value_get_string(&params[3]);
+        event = withValue(event, g_value_get_string(&params[3]), EVENT_VALUE_STRING);
 
-    HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, text, STRING);
-    g_free(minor);
+    HandleEvent(event);
     return TRUE;
 }
 
@@ -732,38 +894,30 @@ gboolean RDKAt::TextRemoveEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::TextRemoveEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_TEXT_REMOVE));
+    if(Rejected(EVENT_MAJOR_TEXT_REMOVE, EVENT_MINOR_TEXT_DELETE, ATK_OBJECT(g_value_get_object(&params[0]))))
+        return TRUE;
 
     AtkObject *accObj;
     guint text_changed_signal_id;
-    GSignalQuery signalQuery;
-    const gchar *major;
-    const gchar *minor_raw = NULL, *text = NULL;
-    gchar *minor;
-    gint d1 = 0, d2 = 0;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    text_changed_signal_id = g_signal_lookup("text-changed", G_OBJECT_TYPE(accObj));
-    g_signal_query(text_changed_signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    text_changed_signal_id = SignalCache::Instance().lookup(TEXT_CHANGED, G_OBJECT_TYPE(accObj));
 
-    minor_raw = g_quark_to_string(signal->detail);
-
-    if(minor_raw)
-        minor = g_strconcat("delete:", minor_raw, NULL);
-    else
-        minor = g_strdup("delete");
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, EVENT_MAJOR_TEXT_REMOVE, EVENT_MINOR_TEXT_DELETE,
+            SignalCache::Instance().name(text_changed_signal_id), g_quark_to_string(signal->detail));
+    event.minorPrefix = "delete";
 
     if(G_VALUE_TYPE(&params[1]) == G_TYPE_INT)
-        d1 = g_value_get_int(&params[1]);
+        event.d1 = g_value_get_int(&params[1]);
 
     if(G_VALUE_TYPE(&params[2]) == G_TYPE_INT)
-        d2 = g_value_get_int(&params[2]);
+        event.d2 = g_value_get_int(&params[2]);
 
     if(G_VALUE_TYPE(&params[3]) == G_TYPE_STRING)
-        text = g_value_get_string(&params[3]);
+        event = withValue(event, g_value_get_string(&params[3]), EVENT_VALUE_STRING);
 
-    HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, text, STRING);
-    g_free(minor);
+    HandleEvent(event);
     return TRUE;
 }
 
@@ -771,32 +925,31 @@ gboolean RDKAt::ChildrenChangedEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::ChildrenChangedEventListener()");
-
-    GSignalQuery signalQuery;
-    const gchar *major, *minor;
-    gint d1 = 0, d2 = 0;
+    ListenerTimer timer(listenerStats(LISTENER_STAT_CHILDREN_CHANGED));
 
     AtkObject *accObj, *tObj=NULL;
     gpointer pChild;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
-    minor = g_quark_to_string(signal->detail);
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, info.major,
+            eventMinorFromQuark(signal->detail), info.name, g_quark_to_string(signal->detail));
 
-    d1 = g_value_get_uint(params + 1);
+    event.d1 = g_value_get_uint(params + 1);
     pChild = g_value_get_pointer(params + 2);
 
     if(ATK_IS_OBJECT(pChild)) {
         tObj = ATK_OBJECT(pChild);
-        HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, tObj, POINTER);
-    } else if((minor != NULL) && (strcmp(minor, "add") == 0)) {
-        tObj = atk_object_ref_accessible_child(accObj, d1);
-        HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, tObj, POINTER);
+        HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
+    } else if(event.minor == EVENT_MINOR_CHILD_ADD) {
+        tObj = atk_object_ref_accessible_child(accObj, event.d1);
+        HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
         g_object_unref(tObj);
     } else {
-        HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, tObj, POINTER);
+        HandleEvent(withValue(event, tObj, EVENT_VALUE_POINTER));
     }
 
     return TRUE;
@@ -806,39 +959,67 @@ gboolean RDKAt::GenericEventListener(GSignalInvocationHint *signal,
         guint param_count, const GValue *params, gpointer data)
 {
     RDKLOG_TRACE("RDKAt::GenericEventListener()");
+    ListenerTimer timer(listenerStats(LISTENER_STAT_GENERIC));
 
-    const gchar *major, *minor;
     AtkObject *accObj;
-    GSignalQuery signalQuery;
-    int d1 = 0, d2 = 0;
 
-    g_signal_query(signal->signal_id, &signalQuery);
-    major = signalQuery.signal_name;
-    minor = g_quark_to_string(signal->detail);
+    const SignalInfo &info = SignalCache::Instance().info(signal->signal_id);
+    if(Rejected(info.major, signal->detail, params))
+        return TRUE;
 
     accObj = ATK_OBJECT(g_value_get_object(&params[0]));
+    EventRecord event = makeEventRecord(accObj, EVENT_CLASS_OBJECT, info.major,
+            eventMinorFromQuark(signal->detail), info.name, g_quark_to_string(signal->detail));
 
     if(param_count > 1 && G_VALUE_TYPE(&params[1]) == G_TYPE_INT)
-        d1 = g_value_get_int(&params[1]);
+        event.d1 = g_value_get_int(&params[1]);
 
     if(param_count > 2 && G_VALUE_TYPE(&params[2]) == G_TYPE_INT)
-        d2 = g_value_get_int(&params[2]);
+        event.d2 = g_value_get_int(&params[2]);
 
-    HandleEvent(accObj, EVENT_OBJECT, major, minor, d1, d2, 0, INT);
+    HandleEvent(event);
 
     return TRUE;
 }
 
-guint RDKAt::addSignalListener(GSignalEmissionHook listener, const char *signal_name)
-{
-    RDKLOG_TRACE("RDKAt::addSignalListener()");
-
-    guint id = atk_add_global_event_listener(listener, signal_name);
-    if(id > 0)
-        g_array_append_val(m_listenerIds, id);
-
-    return id;
-}
+const ListenerEntry RDKAt::s_listeners[] = {
+    { PropertyEventListener, "Atk:AtkObject:property-change", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_PROPERTY_CHANGE, EVENT_MINOR_NONE },
+
+    { WindowEventListener, "window:create", "Atk:AtkWindow:create", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_CREATE, EVENT_MINOR_NONE },
+    { WindowEventListener, "window:destroy", "Atk:AtkWindow:destroy", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_DESTROY, EVENT_MINOR_NONE },
+    { WindowEventListener, "window:minimize", "Atk:AtkWindow:minimize", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_MINIMIZE, EVENT_MINOR_NONE },
+    { WindowEventListener, "window:maximize", "Atk:AtkWindow:maximize", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_MAXIMIZE, EVENT_MINOR_NONE },
+    { WindowEventListener, "window:restore", "Atk:AtkWindow:restore", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_RESTORE, EVENT_MINOR_NONE },
+    { WindowEventListener, "window:activate", "Atk:AtkWindow:activate", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_ACTIVATE, EVENT_MINOR_NONE },
+    { WindowEventListener, "window:deactivate", "Atk:AtkWindow:deactivate", LISTENER_GROUP_DEBUG, EVENT_MAJOR_WINDOW_DEACTIVATE, EVENT_MINOR_NONE },
+
+    { DocumentEventListener, "Atk:AtkDocument:load-complete", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_LOAD_COMPLETE, EVENT_MINOR_NONE },
+    { DocumentEventListener, "Atk:AtkDocument:reload", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_RELOAD, EVENT_MINOR_NONE },
+    { DocumentEventListener, "Atk:AtkDocument:load-stopped", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_LOAD_STOPPED, EVENT_MINOR_NONE },
+
+    { StateEventListener, "Atk:AtkObject:state-change", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_STATE_CHANGED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkObject:visible-data-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_VISIBLE_DATA_CHANGED, EVENT_MINOR_NONE },
+    { ChildrenChangedEventListener, "Atk:AtkObject:children-changed", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_CHILDREN_CHANGED, EVENT_MINOR_NONE },
+    { ActiveDescendantEventListener, "Atk:AtkObject:active-descendant-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_ACTIVE_DESCENDANT_CHANGED, EVENT_MINOR_NONE },
+
+    { GenericEventListener, "Atk:AtkTable:row-inserted", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_ROW_INSERTED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkTable:row-reordered", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_ROW_REORDERED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkTable:row-deleted", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_ROW_DELETED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkTable:column-inserted", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_COLUMN_INSERTED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkTable:column-reordered", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_COLUMN_REORDERED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkTable:column-deleted", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_COLUMN_DELETED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkTable:model-changed", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_MODEL_CHANGED, EVENT_MINOR_NONE },
+    { TextInsertEventListener, "Atk:AtkText:text-insert", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_TEXT_INSERT, EVENT_MINOR_NONE },
+    { TextRemoveEventListener, "Atk:AtkText:text-remove", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_TEXT_REMOVE, EVENT_MINOR_NONE },
+    { TextChangedEventListener, "Atk:AtkText:text-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_TEXT_CHANGED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkText:text-caret-moved", NULL, LISTENER_GROUP_SPEECH, EVENT_MAJOR_TEXT_CARET_MOVED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkText:text-attributes-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_TEXT_ATTRIBUTES_CHANGED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkText:text-selection-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_TEXT_SELECTION_CHANGED, EVENT_MINOR_NONE },
+
+    { BoundsEventListener, "Atk:AtkComponent:bounds-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_BOUNDS_CHANGED, EVENT_MINOR_NONE },
+    { GenericEventListener, "Atk:AtkSelection:selection-changed", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_SELECTION_CHANGED, EVENT_MINOR_NONE },
+    { LinkSelectedEventListener, "Atk:AtkHypertext:link-selected", NULL, LISTENER_GROUP_DEBUG, EVENT_MAJOR_LINK_SELECTED, EVENT_MINOR_NONE }
+};
 
 void RDKAt::initialize()
 {
@@ -849,111 +1030,230 @@ void RDKAt::initialize()
 
     GObject *gObject = (GObject*)g_object_new(ATK_TYPE_OBJECT, NULL);
     AtkObject *atkObject = atk_no_op_object_new(gObject);
-    guint id = 0;
 
     g_object_unref(G_OBJECT(atkObject));
     g_object_unref(gObject);
 
-    if(m_listenerIds) {
+    if(m_listenerSet) {
         g_warning("rdkat-register_event_listeners called multiple times");
         return;
     }
 
-    m_listenerIds = g_array_sized_new(FALSE, TRUE, sizeof(guint), 16);
-    m_focusTrackerId = atk_add_focus_tracker(FocusTracker);
+    initEventTypes();
+    m_filter.load();
+    initRoleDescriptors();
+    buildDispatchTable();
+    for(int major = 0; major < EVENT_MAJOR_COUNT; major++) {
+        for(int minor = 0; minor < EVENT_MINOR_COUNT; minor++) {
+            if(s_invalidators[major][minor])
+                m_filter.keep((EventMajor)major, (EventMinor)minor);
+        }
+    }
 
-    addSignalListener(PropertyEventListener, "Atk:AtkObject:property-change");
+    m_debugging = getenv("ENABLE_RDKAT_DEBUGGING") || is_log_level_enabled(RDK_AT::VERBOSE_LEVEL);
+    m_mainContext = g_main_context_ref_thread_default();
 
-    id = addSignalListener(WindowEventListener, "window:create");
-    if(id != 0) {
-        addSignalListener(WindowEventListener, "window:destroy");
-        addSignalListener(WindowEventListener, "window:minimize");
-        addSignalListener(WindowEventListener, "window:maximize");
-        addSignalListener(WindowEventListener, "window:restore");
-        addSignalListener(WindowEventListener, "window:activate");
-        addSignalListener(WindowEventListener, "window:deactivate");
-    } else {
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:create");
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:destroy");
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:minimize");
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:maximize");
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:restore");
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:activate");
-        addSignalListener(WindowEventListener, "Atk:AtkWindow:deactivate");
+    const char *traceFile = getenv("RDKAT_TRACE_FILE");
+    if(traceFile && *traceFile)
+        m_trace.open(traceFile);
+
+    m_listenerSet = new ListenerSet(s_listeners, G_N_ELEMENTS(s_listeners), &m_filter);
+    m_defaultContext.start(m_mainContext, TTSStateChanged, this, FocusSettled, LiveRegionUpdated);
+
+    // Listeners are attached on demand, see updateListeners()
+    updateListeners();
+}
+
+void RDKAt::updateListeners()
+{
+    if(!m_listenerSet)
+        return;
+
+    // Listeners are shared, they are needed as long as one of the contexts needs them
+    bool process = false, tts = false;
+    const std::vector<ViewContext*> &contexts = m_router.contexts();
+    for(size_t i = 0; i <= contexts.size(); i++) {
+        ViewContext *context = i < contexts.size() ? contexts[i] : &m_defaultContext;
+        if(context->processingEnabled()) {
+            process = true;
+            tts = tts || context->speech().ttsEnabled();
+        }
+    }
+
+    unsigned groups = LISTENER_GROUP_NONE;
+    if(process) {
+        if(tts || m_debugging)
+            groups |= LISTENER_GROUP_SPEECH;
+        if(m_debugging)
+            groups |= LISTENER_GROUP_DEBUG;
+        // A trace is meant to capture the whole event stream
+        if(m_trace.enabled())
+            groups |= LISTENER_GROUP_SPEECH | LISTENER_GROUP_DEBUG;
+    }
+    m_listenerSet->update(groups);
+
+    // Nothing invalidates the caches of a context whose events are dropped, w/o the
+    // speech listeners or by HandleEvent's processing / TTS checks
+    for(size_t i = 0; i <= contexts.size(); i++) {
+        ViewContext *context = i < contexts.size() ? contexts[i] : &m_defaultContext;
+        if(!(groups & LISTENER_GROUP_SPEECH) || !context->processingEnabled() ||
+                (!context->speech().ttsEnabled() && !m_debugging))
+            context->clearCaches();
     }
 
-    addSignalListener(DocumentEventListener, "Atk:AtkDocument:load-complete");
-    addSignalListener(DocumentEventListener, "Atk:AtkDocument:reload");
-    addSignalListener(DocumentEventListener, "Atk:AtkDocument:load-stopped");
+    // Focus tracker & key listener only log
+    bool debug = (groups & LISTENER_GROUP_DEBUG) != 0;
+    bool trackFocus = debug && m_filter.acceptsMajor(EVENT_MAJOR_FOCUS);
+    if(trackFocus && !m_focusTrackerId) {
+        m_focusTrackerId = atk_add_focus_tracker(FocusTracker);
+    } else if(!trackFocus && m_focusTrackerId) {
+        atk_remove_focus_tracker(m_focusTrackerId);
+        m_focusTrackerId = 0;
+    }
 
-    addSignalListener(StateEventListener, "Atk:AtkObject:state-change");
-    addSignalListener(GenericEventListener, "Atk:AtkObject:visible-data-changed");
-    addSignalListener(ChildrenChangedEventListener, "Atk:AtkObject:children-changed");
-    addSignalListener(ActiveDescendantEventListener, "Atk:AtkObject:active-descendant-changed");
+    if(debug && !m_keyEventListenerId) {
+        m_keyEventListenerId = atk_add_key_event_listener(KeyListener, NULL);
+    } else if(!debug && m_keyEventListenerId) {
+        atk_remove_key_event_listener(m_keyEventListenerId);
+        m_keyEventListenerId = 0;
+    }
+}
 
-    addSignalListener(GenericEventListener, "Atk:AtkTable:row-inserted");
-    addSignalListener(GenericEventListener, "Atk:AtkTable:row-reordered");
-    addSignalListener(GenericEventListener, "Atk:AtkTable:row-deleted");
-    addSignalListener(GenericEventListener, "Atk:AtkTable:column-inserted");
-    addSignalListener(GenericEventListener, "Atk:AtkTable:column-reordered");
-    addSignalListener(GenericEventListener, "Atk:AtkTable:column-deleted");
-    addSignalListener(GenericEventListener, "Atk:AtkTable:model-changed");
-    addSignalListener(TextInsertEventListener, "Atk:AtkText:text-insert");
-    addSignalListener(TextRemoveEventListener, "Atk:AtkText:text-remove");
-    addSignalListener(TextChangedEventListener, "Atk:AtkText:text-changed");
-    addSignalListener(GenericEventListener, "Atk:AtkText:text-caret-moved");
-    addSignalListener(GenericEventListener, "Atk:AtkText:text-attributes-changed");
-    addSignalListener(GenericEventListener, "Atk:AtkText:text-selection-changed");
+gboolean RDKAt::UpdateListenersCallback(gpointer data)
+{
+    static_cast<RDKAt*>(data)->updateListeners();
+    return G_SOURCE_REMOVE;
+}
 
-    addSignalListener(BoundsEventListener, "Atk:AtkComponent:bounds-changed");
-    addSignalListener(GenericEventListener, "Atk:AtkSelection:selection-changed");
-    addSignalListener(LinkSelectedEventListener, "Atk:AtkHypertext:link-selected");
+void RDKAt::TTSStateChanged(bool, void *data)
+{
+    RDKAt *self = static_cast<RDKAt*>(data);
 
-    m_keyEventListenerId = atk_add_key_event_listener(KeyListener, NULL);
+    // Listeners must only be (de)registered from the thread which emits ATK signals
+    if(self->m_mainContext)
+        g_main_context_invoke(self->m_mainContext, UpdateListenersCallback, self);
 }
 
-void RDKAt::enableProcessing(bool enable)
+ViewContext* RDKAt::createContext(AtkObject *root)
 {
-    RDKLOG_INFO("processingEnabled=%d, enable=%d", processingEnabled(), enable);
-    m_process = enable;
-    m_shouldCreateSession = enable;
+    if(!m_initialized || !root) {
+        RDKLOG_ERROR("Can't create a context, initialized=%d, root=%p", m_initialized, root);
+        return NULL;
+    }
 
-    createOrDestroySession();
+    ViewContext *context = new ViewContext(root);
+    context->start(m_mainContext, TTSStateChanged, this, FocusSettled, LiveRegionUpdated);
+    {
+        std::lock_guard<std::mutex> lock(m_contextsMutex);
+        m_router.add(context);
+    }
+    RDKLOG_INFO("Created context %u for root %p", context->id(), root);
+    return context;
+}
 
-    if(m_sessionId)
-        m_ttsClient->abort(m_sessionId);
+void RDKAt::destroyContext(ViewContext *context)
+{
+    if(!context || context == &m_defaultContext)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_contextsMutex);
+        m_router.remove(context);
+    }
+    RDKLOG_INFO("Destroying context %u", context->id());
+    delete context;
+    updateListeners();
+}
+
+void RDKAt::enableProcessing(ViewContext *context, bool enable)
+{
+    m_debugging = getenv("ENABLE_RDKAT_DEBUGGING") || is_log_level_enabled(RDK_AT::VERBOSE_LEVEL);
+    context->enableProcessing(enable);
+    updateListeners();
+}
+
+void RDKAt::setVolumeControlCallback(ViewContext *context, MediaVolumeControlCallback cb, void *data)
+{
+    context->setVolumeControlCallback(cb, data);
 }
 
-void RDKAt::setVolumeControlCallback(MediaVolumeControlCallback cb, void *data)
+void RDKAt::statistics(std::string &out)
 {
-    RDKAt::Instance().m_mediaVolumeControlCB = cb;
-    RDKAt::Instance().m_mediaVolumeControlCBData = data;
+    // Only counters readable from any thread are reported
+    StatsWriter w(out);
+    w.beginObject();
+
+    w.beginObject("listeners");
+    for(int i = 0; i < LISTENER_STAT_COUNT; i++)
+        w.listener(listenerStatName((ListenerStat)i), m_listenerStats[i]);
+    w.field("avoided_invocations", ListenerSet::avoidedInvocations());
+    w.endObject();
+
+    w.histogram("handle_event", m_handleEventTime);
+    w.histogram("focus_settled", m_focusSettledTime);
+
+    // The default context is reported at the top level, the others below "contexts"
+    std::lock_guard<std::mutex> lock(m_contextsMutex);
+    m_defaultContext.statistics(w);
+
+    const std::vector<ViewContext*> &contexts = m_router.contexts();
+    w.beginObject("contexts");
+    for(size_t i = 0; i < contexts.size(); i++) {
+        char id[16];
+        snprintf(id, sizeof(id), "%u", contexts[i]->id());
+        w.beginObject(id);
+        contexts[i]->statistics(w);
+        w.endObject();
+    }
+    w.endObject();
+
+    w.beginObject("routing");
+    w.field("hits", m_router.hits());
+    w.field("misses", m_router.misses());
+    w.endObject();
+
+    w.field("log_dropped", log_dropped_count());
+    w.field("trace_records", m_trace.recordCount());
+
+    w.endObject();
 }
 
 void RDKAt::uninitialize(void)
 {
     RDKLOG_TRACE("RDKAt::uninitialize()");
 
-    guint i;
-    GArray *ids = m_listenerIds;
-    m_listenerIds = NULL;
+    ListenerSet *listenerSet = m_listenerSet;
+    m_listenerSet = NULL;
+    delete listenerSet;
+
+    std::vector<ViewContext*> contexts;
+    {
+        std::lock_guard<std::mutex> lock(m_contextsMutex);
+        contexts = m_router.contexts();
+        for(size_t i = 0; i < contexts.size(); i++)
+            m_router.remove(contexts[i]);
+    }
+    for(size_t i = 0; i < contexts.size(); i++)
+        delete contexts[i];
+
+    m_defaultContext.stop();
+    m_trace.close();
 
     if(m_focusTrackerId) {
         atk_remove_focus_tracker(m_focusTrackerId);
         m_focusTrackerId = 0;
     }
 
-    if(ids) {
-        for(i = 0; i < ids->len; i++) {
-            atk_remove_global_event_listener(g_array_index(ids, guint, i));
-        }
-        g_array_free(ids, TRUE);
-    }
-
     if(m_keyEventListenerId) {
         atk_remove_key_event_listener(m_keyEventListenerId);
         m_keyEventListenerId = 0;
     }
+
+    if(m_mainContext) {
+        g_main_context_unref(m_mainContext);
+        m_mainContext = NULL;
+    }
+    m_initialized = false;
 }
 
 void Initialize()
@@ -966,14 +1266,49 @@ void Initialize()
 
 void EnableProcessing(bool enable)
 {
+    logger_refresh();
     RDKLOG_INFO("RDK_AT::EnableProcessing()");
-    RDKAt::Instance().enableProcessing(enable);
+    RDKAt::Instance().enableProcessing(RDKAt::Instance().defaultContext(), enable);
 }
 
 void SetVolumeControlCallback(MediaVolumeControlCallback cb, void *data)
 {
     RDKLOG_INFO("RDK_AT::SetVolumeControlCallback()");
-    RDKAt::Instance().setVolumeControlCallback(cb, data);
+    RDKAt::Instance().setVolumeControlCallback(RDKAt::Instance().defaultContext(), cb, data);
+}
+
+ViewContext* CreateContext(AtkObject *root)
+{
+    RDKLOG_INFO("RDK_AT::CreateContext()");
+    return RDKAt::Instance().createContext(root);
+}
+
+void EnableProcessing(ViewContext *context, bool enable)
+{
+    logger_refresh();
+    RDKLOG_INFO("RDK_AT::EnableProcessing(context)");
+    if(context)
+        RDKAt::Instance().enableProcessing(context, enable);
+}
+
+void SetVolumeControlCallback(ViewContext *context, MediaVolumeControlCallback cb, void *data)
+{
+    RDKLOG_INFO("RDK_AT::SetVolumeControlCallback(context)");
+    if(context)
+        RDKAt::Instance().setVolumeControlCallback(context, cb, data);
+}
+
+void DestroyContext(ViewContext *context)
+{
+    RDKLOG_INFO("RDK_AT::DestroyContext()");
+    RDKAt::Instance().destroyContext(context);
+}
+
+std::string GetStatistics()
+{
+    std::string out;
+    RDKAt::Instance().statistics(out);
+    return out;
 }
 
 void Uninitialize()
@@ -24,6 +24,8 @@
 #include <string>
 #include <list>
 
+typedef struct _AtkObject AtkObject;
+
 namespace RDK_AT {
 
 // This callback is set from the caller to facilitate RDK_AT to control media volume on need.
@@ -35,8 +37,24 @@ typedef void (*MediaVolumeControlCallback)(void *data, float volume);
 void Initialize();
 void EnableProcessing(bool enable);
 void SetVolumeControlCallback(MediaVolumeControlCallback cb, void *data);
+
+// Returns the runtime statistics as a JSON object, may be called from any thread.
+// Durations are in nanoseconds; histogram bucket i counts durations below 2^(i+1) ns.
+std::string GetStatistics();
 void Uninitialize();
 
+// Views sharing the process, e.g. several WPE web views, each get a context bound
+// to the root of their accessible tree: own TTS session, speech queue & caches.
+// An event goes to the context of its nearest root ancestor; the functions
+// above act on the default context, which gets the events no context claims.
+// To be called after Initialize() from the thread emitting ATK events, the
+// root is referenced until DestroyContext().
+class ViewContext;
+ViewContext* CreateContext(AtkObject *root);
+void EnableProcessing(ViewContext *context, bool enable);
+void SetVolumeControlCallback(ViewContext *context, MediaVolumeControlCallback cb, void *data);
+void DestroyContext(ViewContext *context);
+
 }
 
 #endif // RDK_AT_H
@@ -0,0 +1,164 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "role_descriptor.h"
+#include "logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace RDK_AT
+{
+
+namespace {
+
+struct RoleTable {
+    RoleDescriptor entries[ATK_ROLE_LAST_DEFINED];
+};
+
+constexpr RoleTable makeRoleTable()
+{
+    RoleTable t = {};
+    t.entries[ATK_ROLE_CHECK_BOX]        = RoleDescriptor{ "check box", ROLE_STATE_CHECKED, ROLE_VERBOSITY_BRIEF };
+    t.entries[ATK_ROLE_RADIO_BUTTON]     = RoleDescriptor{ "radio button", ROLE_STATE_CHECKED, ROLE_VERBOSITY_BRIEF };
+    t.entries[ATK_ROLE_TOGGLE_BUTTON]    = RoleDescriptor{ "toggle button", ROLE_STATE_PRESSED, ROLE_VERBOSITY_BRIEF };
+    t.entries[ATK_ROLE_COMBO_BOX]        = RoleDescriptor{ "combo box", ROLE_STATE_EXPANDED, ROLE_VERBOSITY_BRIEF };
+    t.entries[ATK_ROLE_CHECK_MENU_ITEM]  = RoleDescriptor{ "menu item", ROLE_STATE_CHECKED, ROLE_VERBOSITY_BRIEF };
+    t.entries[ATK_ROLE_RADIO_MENU_ITEM]  = RoleDescriptor{ "menu item", ROLE_STATE_CHECKED, ROLE_VERBOSITY_BRIEF };
+
+    t.entries[ATK_ROLE_PUSH_BUTTON]      = RoleDescriptor{ "button", ROLE_STATE_EXPANDED, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_LINK]             = RoleDescriptor{ "link", ROLE_STATE_NONE, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_MENU]             = RoleDescriptor{ "menu", ROLE_STATE_EXPANDED, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_MENU_ITEM]        = RoleDescriptor{ "menu item", ROLE_STATE_EXPANDED, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_PAGE_TAB]         = RoleDescriptor{ "tab", ROLE_STATE_SELECTED, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_SLIDER]           = RoleDescriptor{ "slider", ROLE_STATE_NONE, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_SPIN_BUTTON]      = RoleDescriptor{ "spin button", ROLE_STATE_NONE, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_LIST_ITEM]        = RoleDescriptor{ "list item", ROLE_STATE_SELECTED, ROLE_VERBOSITY_NORMAL };
+    t.entries[ATK_ROLE_TREE_ITEM]        = RoleDescriptor{ "tree item", ROLE_STATE_EXPANDED | ROLE_STATE_SELECTED, ROLE_VERBOSITY_NORMAL };
+
+    t.entries[ATK_ROLE_HEADING]          = RoleDescriptor{ "heading", ROLE_STATE_NONE, ROLE_VERBOSITY_VERBOSE };
+    t.entries[ATK_ROLE_IMAGE]            = RoleDescriptor{ "image", ROLE_STATE_NONE, ROLE_VERBOSITY_VERBOSE };
+    t.entries[ATK_ROLE_PROGRESS_BAR]     = RoleDescriptor{ "progress bar", ROLE_STATE_NONE, ROLE_VERBOSITY_VERBOSE };
+    t.entries[ATK_ROLE_PAGE_TAB_LIST]    = RoleDescriptor{ "tab list", ROLE_STATE_NONE, ROLE_VERBOSITY_VERBOSE };
+    t.entries[ATK_ROLE_LIST_BOX]         = RoleDescriptor{ "list box", ROLE_STATE_NONE, ROLE_VERBOSITY_VERBOSE };
+    return t;
+}
+
+constexpr RoleTable s_roles = makeRoleTable();
+
+static_assert(s_roles.entries[ATK_ROLE_CHECK_BOX].states == ROLE_STATE_CHECKED,
+    "role table must be built at compile time");
+
+struct StatePhrase {
+    RoleState state;
+    AtkStateType atkState;
+    const char *on;
+    const char *off; // NULL when only the set state is worth announcing
+};
+
+const StatePhrase s_statePhrases[] = {
+    { ROLE_STATE_CHECKED,  ATK_STATE_CHECKED,  "checked",  "unchecked" },
+    { ROLE_STATE_PRESSED,  ATK_STATE_PRESSED,  "pressed",  "not pressed" },
+    { ROLE_STATE_EXPANDED, ATK_STATE_EXPANDED, "expanded", "collapsed" },
+    { ROLE_STATE_SELECTED, ATK_STATE_SELECTED, "selected", NULL }
+};
+
+const RoleDescriptor s_unknownRole = { NULL, ROLE_STATE_NONE, ROLE_VERBOSITY_VERBOSE };
+
+uint8_t s_verbosity = ROLE_VERBOSITY_NORMAL;
+
+} // namespace
+
+void initRoleDescriptors()
+{
+    s_verbosity = ROLE_VERBOSITY_NORMAL;
+
+    const char *verbosity = getenv("RDKAT_SPEECH_VERBOSITY");
+    if(!verbosity)
+        return;
+
+    if(strcasecmp(verbosity, "brief") == 0)
+        s_verbosity = ROLE_VERBOSITY_BRIEF;
+    else if(strcasecmp(verbosity, "verbose") == 0)
+        s_verbosity = ROLE_VERBOSITY_VERBOSE;
+    else if(strcasecmp(verbosity, "normal") != 0)
+        RDKLOG_WARNING("Unknown speech verbosity \"%s\", using normal", verbosity);
+}
+
+const RoleDescriptor& roleDescriptor(AtkRole role)
+{
+    // Custom roles registered at runtime are never announced
+    if(role < 0 || role >= ATK_ROLE_LAST_DEFINED)
+        return s_unknownRole;
+    return s_roles.entries[role];
+}
+
+uint8_t roleStates(AtkObject *obj, const RoleDescriptor &desc, uint8_t &relevant)
+{
+    relevant = desc.states;
+    if(!desc.states || !desc.suffix)
+        return ROLE_STATE_NONE;
+
+    AtkStateSet *set = atk_object_ref_state_set(obj);
+    if(!set) {
+        relevant = ROLE_STATE_NONE;
+        return ROLE_STATE_NONE;
+    }
+
+    uint8_t active = ROLE_STATE_NONE;
+    for(const StatePhrase &phrase : s_statePhrases) {
+        if((desc.states & phrase.state) && atk_state_set_contains_state(set, phrase.atkState))
+            active |= phrase.state;
+    }
+
+    if((desc.states & ROLE_STATE_EXPANDED) && !atk_state_set_contains_state(set, ATK_STATE_EXPANDABLE))
+        relevant &= ~ROLE_STATE_EXPANDED;
+
+    // GTK exposes toggle buttons as checked, WebKit (aria-pressed) as pressed
+    if((desc.states & ROLE_STATE_PRESSED) && atk_state_set_contains_state(set, ATK_STATE_CHECKED))
+        active |= ROLE_STATE_PRESSED;
+
+    g_object_unref(set);
+    return active & relevant;
+}
+
+void appendRoleText(std::string &text, const RoleDescriptor &desc, uint8_t relevant, uint8_t active)
+{
+    if(!desc.suffix || desc.verbosity > s_verbosity)
+        return;
+
+    text += ' ';
+    text += desc.suffix;
+
+    bool first = true;
+    for(const StatePhrase &phrase : s_statePhrases) {
+        if(!(relevant & phrase.state))
+            continue;
+
+        const char *word = (active & phrase.state) ? phrase.on : phrase.off;
+        if(!word)
+            continue;
+
+        text += first ? " is " : " and ";
+        text += word;
+        first = false;
+    }
+}
+
+} // namespace RDK_AT
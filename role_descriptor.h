@@ -0,0 +1,76 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_ROLE_DESCRIPTOR_H
+#define RDK_AT_ROLE_DESCRIPTOR_H
+
+#include <atk/atk.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace RDK_AT
+{
+
+// States worth announcing along with a role
+enum RoleState : uint8_t {
+    ROLE_STATE_NONE     = 0,
+    ROLE_STATE_CHECKED  = 1 << 0,
+    ROLE_STATE_PRESSED  = 1 << 1,
+    ROLE_STATE_EXPANDED = 1 << 2, // only when the object is expandable
+    ROLE_STATE_SELECTED = 1 << 3
+};
+
+// Least speech verbosity at which a role is announced, see RDKAT_SPEECH_VERBOSITY
+enum RoleVerbosity : uint8_t {
+    ROLE_VERBOSITY_BRIEF,   // the role carries state the user acts upon
+    ROLE_VERBOSITY_NORMAL,  // the role tells how to interact with the element
+    ROLE_VERBOSITY_VERBOSE  // informational only
+};
+
+struct RoleDescriptor {
+    const char *suffix;  // spoken after the name, NULL when the role is not announced
+    uint8_t states;      // RoleState mask
+    uint8_t verbosity;   // RoleVerbosity
+};
+
+/**
+ * @brief Reads the speech verbosity from RDKAT_SPEECH_VERBOSITY
+ * ("brief", "normal" or "verbose", default "normal").
+ */
+void initRoleDescriptors();
+
+const RoleDescriptor& roleDescriptor(AtkRole role);
+
+/**
+ * @brief Returns the mask of the descriptor states which are set on obj.
+ * relevant receives the states which apply to obj, e.g. expanded is dropped
+ * for objects which aren't expandable. The state set is only fetched when
+ * the role has states.
+ */
+uint8_t roleStates(AtkObject *obj, const RoleDescriptor &desc, uint8_t &relevant);
+
+/**
+ * @brief Appends " <suffix> is <state>[ and <state>]" to text, e.g.
+ * " check box is checked", if the role is announced at the current verbosity.
+ */
+void appendRoleText(std::string &text, const RoleDescriptor &desc, uint8_t relevant, uint8_t active);
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_ROLE_DESCRIPTOR_H
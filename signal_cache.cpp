@@ -0,0 +1,66 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "signal_cache.h"
+#include "logger.h"
+
+namespace RDK_AT
+{
+
+SignalCache& SignalCache::Instance()
+{
+    static SignalCache cache;
+    return cache;
+}
+
+const SignalInfo& SignalCache::info(guint signalId)
+{
+    if(G_LIKELY(signalId < m_resolved.size() && m_resolved[signalId]))
+        return m_infos[signalId];
+
+    if(signalId >= m_infos.size()) {
+        m_infos.resize(signalId + 1);
+        m_resolved.resize(signalId + 1, false);
+    }
+
+    GSignalQuery signalQuery;
+    g_signal_query(signalId, &signalQuery);
+
+    SignalInfo &info = m_infos[signalId];
+    info.name = g_intern_string(signalQuery.signal_id ? signalQuery.signal_name : "");
+    info.major = eventMajorFromName(info.name);
+    m_resolved[signalId] = true;
+
+    RDKLOG_VERBOSE("Resolved signal %u as \"%s\" (major=%d)", signalId, info.name, info.major);
+    return info;
+}
+
+guint SignalCache::lookup(const gchar *name, GType type)
+{
+    LookupKey key = { name, type };
+    auto it = m_lookups.find(key);
+    if(G_LIKELY(it != m_lookups.end()))
+        return it->second;
+
+    guint id = g_signal_lookup(name, type);
+    m_lookups.emplace(key, id);
+    return id;
+}
+
+} // namespace RDK_AT
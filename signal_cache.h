@@ -0,0 +1,80 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_SIGNAL_CACHE_H
+#define RDK_AT_SIGNAL_CACHE_H
+
+#include "event_types.h"
+
+#include <glib.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace RDK_AT
+{
+
+/**
+ * Metadata of a GSignal, resolved once per signal id.
+ */
+struct SignalInfo {
+    const gchar *name; // interned, may be compared by pointer
+    EventMajor major;
+};
+
+/**
+ * @brief Caches g_signal_query() / g_signal_lookup() results
+ * Signal ids are small and dense, so per id metadata lives in a plain array.
+ * Lookups by (name, GType) are cached in a hash map.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class SignalCache {
+public:
+    static SignalCache& Instance();
+
+    const SignalInfo& info(guint signalId);
+    const gchar* name(guint signalId) { return info(signalId).name; }
+
+    // Cached g_signal_lookup(), name must be a static string
+    guint lookup(const gchar *name, GType type);
+
+private:
+    SignalCache() {}
+    SignalCache(const SignalCache &);
+    SignalCache& operator=(const SignalCache &);
+
+    struct LookupKey {
+        const gchar *name;
+        GType type;
+        bool operator==(const LookupKey &o) const { return name == o.name && type == o.type; }
+    };
+    struct LookupKeyHash {
+        size_t operator()(const LookupKey &k) const {
+            return std::hash<const void*>()(k.name) ^ (std::hash<GType>()(k.type) << 1);
+        }
+    };
+
+    std::vector<SignalInfo> m_infos;
+    std::vector<bool> m_resolved;
+    std::unordered_map<LookupKey, guint, LookupKeyHash> m_lookups;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_SIGNAL_CACHE_H
@@ -0,0 +1,750 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "speech_dispatcher.h"
+#include "logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace RDK_AT
+{
+
+static const size_t kDefaultQueueSize = 8;
+static const guint kDefaultReconnectMinMs = 250;
+static const guint kDefaultReconnectMaxMs = 30000;
+static const guint kDefaultHoldMs = 2000;
+static const guint kDefaultConnectTimeoutMs = 5000;
+
+const char* connectionStateName(ConnectionState state)
+{
+    switch(state) {
+    case CONNECTION_IDLE:       return "idle";
+    case CONNECTION_CONNECTING: return "connecting";
+    case CONNECTION_CONNECTED:  return "connected";
+    case CONNECTION_BACKOFF:    return "backoff";
+    }
+    return "unknown";
+}
+
+GSourceFuncs SpeechDispatcher::s_queueSourceFuncs = {
+    SpeechDispatcher::QueuePrepare,
+    SpeechDispatcher::QueueCheck,
+    SpeechDispatcher::QueueDispatch,
+    NULL
+};
+
+// Ready time based, like the coalescer's, armed with the backoff delay
+GSourceFuncs SpeechDispatcher::s_reconnectSourceFuncs = {
+    NULL,
+    NULL,
+    SpeechDispatcher::ReconnectDispatch,
+    NULL
+};
+
+GSourceFuncs SpeechDispatcher::s_holdSourceFuncs = {
+    NULL,
+    NULL,
+    SpeechDispatcher::HoldDispatch,
+    NULL
+};
+
+SpeechDispatcher::SpeechDispatcher() :
+    m_context(NULL),
+    m_loop(NULL),
+    m_queueSource(NULL),
+    m_reconnectSource(NULL),
+    m_holdSource(NULL),
+    m_pending(0),
+    m_capacity(kDefaultQueueSize),
+    m_stateCB(NULL),
+    m_stateCBData(NULL),
+    m_ttsEnabled(false),
+    m_process(false),
+    m_shouldCreateSession(false),
+    m_sessionOpen(false),
+    m_speechId(0),
+    m_sink(NULL),
+    m_sinkGeneration(1),
+    m_reconnectMinMs(kDefaultReconnectMinMs),
+    m_reconnectMaxMs(kDefaultReconnectMaxMs),
+    m_reconnectDelayMs(kDefaultReconnectMinMs),
+    m_connectTimeoutMs(kDefaultConnectTimeoutMs),
+    m_everConnected(false),
+    m_holdMs(kDefaultHoldMs),
+    m_holdUntil(0),
+    m_readySince(0),
+    m_speaking(false),
+    m_currentPriority(SPEECH_PRIORITY_LIVE),
+    m_connectionState(CONNECTION_IDLE),
+    m_ready(false),
+    m_timeToReadyUs(-1),
+    m_connectAttempts(0),
+    m_disconnects(0),
+    m_reconnects(0),
+    m_queuedSpeech(0),
+    m_maxQueuedSpeech(0),
+    m_dropped(0),
+    m_spoken(0),
+    m_aborted(0),
+    m_lastLatencyUs(0),
+    m_maxLatencyUs(0),
+    m_totalLatencyUs(0)
+{
+    memset(m_inFlight, 0, sizeof(m_inFlight));
+
+    const char *size = getenv("RDKAT_SPEECH_QUEUE_SIZE");
+    if(size && atoi(size) > 0)
+        m_capacity = atoi(size);
+
+    const char *ms = getenv("RDKAT_RECONNECT_MIN_MS");
+    if(ms && atoi(ms) > 0)
+        m_reconnectMinMs = atoi(ms);
+    ms = getenv("RDKAT_RECONNECT_MAX_MS");
+    if(ms && atoi(ms) > 0)
+        m_reconnectMaxMs = atoi(ms);
+    ms = getenv("RDKAT_SPEECH_CONNECT_TIMEOUT_MS");
+    if(ms && atoi(ms) > 0)
+        m_connectTimeoutMs = atoi(ms);
+    ms = getenv("RDKAT_SPEECH_HOLD_MS");
+    if(ms)
+        m_holdMs = atoi(ms);
+    if(m_reconnectMaxMs < m_reconnectMinMs)
+        m_reconnectMaxMs = m_reconnectMinMs;
+    m_reconnectDelayMs = m_reconnectMinMs;
+}
+
+SpeechDispatcher::~SpeechDispatcher()
+{
+    stop();
+}
+
+void SpeechDispatcher::start(TTSStateCallback cb, void *data)
+{
+    if(m_thread.joinable())
+        return;
+
+    m_stateCB = cb;
+    m_stateCBData = data;
+
+    m_context = g_main_context_new();
+    m_loop = g_main_loop_new(m_context, FALSE);
+
+    m_queueSource = g_source_new(&s_queueSourceFuncs, sizeof(QueueSource));
+    reinterpret_cast<QueueSource*>(m_queueSource)->dispatcher = this;
+    g_source_set_name(m_queueSource, "rdkat-speech-queue");
+    g_source_attach(m_queueSource, m_context);
+
+    m_reconnectSource = g_source_new(&s_reconnectSourceFuncs, sizeof(QueueSource));
+    reinterpret_cast<QueueSource*>(m_reconnectSource)->dispatcher = this;
+    g_source_set_name(m_reconnectSource, "rdkat-speech-reconnect");
+    g_source_set_ready_time(m_reconnectSource, -1);
+    g_source_attach(m_reconnectSource, m_context);
+
+    m_holdSource = g_source_new(&s_holdSourceFuncs, sizeof(QueueSource));
+    reinterpret_cast<QueueSource*>(m_holdSource)->dispatcher = this;
+    g_source_set_name(m_holdSource, "rdkat-speech-hold");
+    g_source_set_ready_time(m_holdSource, -1);
+    g_source_attach(m_holdSource, m_context);
+    m_ducking.start(m_context);
+
+    m_thread = std::thread(&SpeechDispatcher::run, this);
+
+    // Warm up the connection before anything is to be said
+    Command cmd = {};
+    cmd.type = CMD_CONNECT;
+    post(cmd);
+}
+
+void SpeechDispatcher::stop()
+{
+    if(!m_thread.joinable())
+        return;
+
+    Command cmd = {};
+    cmd.type = CMD_QUIT;
+    post(cmd);
+    m_thread.join();
+
+    m_ducking.stop();
+    g_source_destroy(m_holdSource);
+    g_source_unref(m_holdSource);
+    m_holdSource = NULL;
+    g_source_destroy(m_reconnectSource);
+    g_source_unref(m_reconnectSource);
+    m_reconnectSource = NULL;
+    g_source_destroy(m_queueSource);
+    g_source_unref(m_queueSource);
+    m_queueSource = NULL;
+    g_main_loop_unref(m_loop);
+    m_loop = NULL;
+    g_main_context_unref(m_context);
+    m_context = NULL;
+
+    // Stale utterances are dropped, settings are kept for the next start()
+    std::vector<Command> kept;
+    while(m_queue.pop(cmd)) {
+        m_pending--;
+        if(cmd.type != CMD_SPEAK && cmd.type != CMD_QUIT)
+            kept.push_back(std::move(cmd));
+    }
+    for(size_t i = 0; i < kept.size(); i++) {
+        m_pending++;
+        m_queue.push(std::move(kept[i]));
+    }
+    m_queuedSpeech = 0;
+}
+
+void SpeechDispatcher::run()
+{
+    g_main_context_push_thread_default(m_context);
+    g_main_loop_run(m_loop);
+
+    // Tear down the session from the thread which owns it
+    m_scheduler.clear();
+    m_speaking = false;
+    m_process = false;
+    createOrDestroySession();
+    m_ducking.release();
+    dropSink();
+    g_source_set_ready_time(m_reconnectSource, -1);
+    m_reconnectDelayMs = m_reconnectMinMs;
+    m_everConnected = false;
+    setConnectionState(CONNECTION_IDLE);
+    updateReadiness();
+
+    g_main_context_pop_thread_default(m_context);
+}
+
+void SpeechDispatcher::post(Command &cmd)
+{
+    // Called from the ATK & sink threads, aborts are resolved by drain(). The cap holds
+    // while the dispatcher thread is stuck in a sink call, the newest utterance is dropped
+    if(cmd.type == CMD_SPEAK) {
+        size_t depth = ++m_queuedSpeech;
+        if(depth > m_capacity) {
+            m_queuedSpeech--;
+            m_dropped++;
+            RDKLOG_WARNING("Speech queue is full, dropping \"%s\"", cmd.text.c_str());
+            return;
+        }
+        if(depth > m_maxQueuedSpeech.load(std::memory_order_relaxed))
+            m_maxQueuedSpeech = depth;
+    }
+    m_pending++;
+    m_queue.push(std::move(cmd));
+
+    if(m_context)
+        g_main_context_wakeup(m_context);
+}
+
+void SpeechDispatcher::notify(Command &cmd)
+{
+    cmd.sinkGeneration = m_sinkGeneration.load(std::memory_order_relaxed);
+    post(cmd);
+}
+
+void SpeechDispatcher::prune(std::vector<Command> &batch)
+{
+    for(size_t i = 0; i < batch.size(); i++) {
+        if(batch[i].type != CMD_ABORT)
+            continue;
+
+        // What hasn't been said about the previous element is stale as well
+        for(size_t j = 0; j < i;) {
+            if(batch[j].type == CMD_SPEAK && speechPriorityFocusBound(batch[j].priority)) {
+                batch.erase(batch.begin() + j);
+                m_dropped++;
+                i--;
+            } else {
+                j++;
+            }
+        }
+    }
+}
+
+void SpeechDispatcher::drain()
+{
+    // Everything posted so far is taken at once, so that aborts can look ahead
+    Command cmd;
+    while(m_queue.pop(cmd)) {
+        m_pending--;
+        if(cmd.type == CMD_SPEAK)
+            m_queuedSpeech--;
+        m_batch.push_back(std::move(cmd));
+    }
+    prune(m_batch);
+
+    for(size_t i = 0; i < m_batch.size(); i++)
+        handle(m_batch[i]);
+    m_batch.clear();
+}
+
+void SpeechDispatcher::handle(Command &cmd)
+{
+    if(cmd.sinkGeneration && cmd.sinkGeneration != m_sinkGeneration.load(std::memory_order_relaxed)) {
+        RDKLOG_VERBOSE("Ignoring a notification from a replaced speech sink");
+        return;
+    }
+
+    switch(cmd.type) {
+    case CMD_CONNECT:
+        if(connectionState() == CONNECTION_IDLE)
+            m_readySince = g_get_monotonic_time();
+        ensureSinkConnection();
+        break;
+
+    case CMD_SPEAK:
+        schedule(cmd);
+        break;
+
+    case CMD_ENABLE_PROCESSING:
+        m_process = cmd.enable;
+        m_shouldCreateSession = cmd.enable;
+        if(m_process) {
+            m_holdUntil = g_get_monotonic_time() + (gint64)m_holdMs * 1000;
+            if(!m_ready && !m_readySince)
+                m_readySince = g_get_monotonic_time();
+            ensureSinkConnection();
+        }
+        createOrDestroySession();
+        if(m_sessionOpen)
+            m_sink->abort();
+        if(!m_process) {
+            m_scheduler.clear();
+            m_speaking = false;
+        }
+        updateReadiness();
+        break;
+
+    case CMD_SET_VOLUME_CALLBACK:
+        m_ducking.setCallback(cmd.volumeCB, cmd.volumeCBData);
+        break;
+
+    case CMD_SERVER_CONNECTED:
+        g_source_set_ready_time(m_reconnectSource, -1);
+        m_reconnectDelayMs = m_reconnectMinMs;
+        if(m_everConnected)
+            m_reconnects++;
+        m_everConnected = true;
+        setConnectionState(CONNECTION_CONNECTED);
+
+        // Handle TTSEngine crash & reconnection
+        if(m_process) {
+            m_shouldCreateSession = true;
+            createOrDestroySession();
+        }
+        updateReadiness();
+        break;
+
+    case CMD_SERVER_CLOSED:
+        if(m_sink)
+            m_sink->closeSession();
+        m_sessionOpen = false;
+        m_shouldCreateSession = false;
+
+        // Only the latest focus / state utterance is worth saying once back
+        m_scheduler.keepLatestFocusBound();
+        if(m_scheduler.empty() && m_speaking && speechPriorityFocusBound(m_current.priority))
+            m_scheduler.push(m_current, false, m_current.priority);
+        m_speaking = false;
+        m_ducking.release();
+
+        m_disconnects++;
+        scheduleReconnect();
+        updateReadiness();
+        break;
+
+    case CMD_READINESS_CHANGED:
+        updateReadiness();
+        break;
+
+    case CMD_SPEECH_STARTED:
+        speechStarted(cmd);
+        break;
+
+    case CMD_SPEECH_DONE:
+        speechFinished(cmd);
+        // Ignore the completion of an utterance which got superseded already
+        if(cmd.speechId != m_speechId)
+            break;
+        m_speaking = false;
+        speakNext();
+        break;
+
+    case CMD_ABORT:
+        m_scheduler.dropFocusBound();
+        // Document & live speech is left to be interrupted by the next focus utterance
+        if(m_speaking && speechPriorityFocusBound(m_currentPriority)) {
+            if(m_sessionOpen)
+                m_sink->abort();
+            m_aborted++;
+            m_speaking = false;
+            speakNext();
+        }
+        break;
+
+    case CMD_QUIT:
+        g_main_loop_quit(m_loop);
+        break;
+    }
+}
+
+void SpeechDispatcher::ensureSinkConnection()
+{
+    if(connectionState() == CONNECTION_IDLE)
+        connectSink();
+}
+
+void SpeechDispatcher::connectSink()
+{
+    dropSink();
+
+    m_connectAttempts++;
+    setConnectionState(CONNECTION_CONNECTING);
+    m_sink = createSpeechSink();
+    if(!m_sink->connect(this)) {
+        RDKLOG_ERROR("Unable to connect the %s speech sink", m_sink->name());
+        dropSink();
+        scheduleReconnect();
+        return;
+    }
+
+    // Sinks report the connection asynchronously, give up on it if that doesn't come
+    if(connectionState() == CONNECTION_CONNECTING) {
+        RDKLOG_VERBOSE("Speech sink connection attempt times out in %ums", m_connectTimeoutMs);
+        g_source_set_ready_time(m_reconnectSource, g_get_monotonic_time() + (gint64)m_connectTimeoutMs * 1000);
+    }
+}
+
+void SpeechDispatcher::dropSink()
+{
+    if(!m_sink)
+        return;
+
+    // Once deleted, the sink doesn't call back, what it posted before is ignored
+    delete m_sink;
+    m_sink = NULL;
+    m_sinkGeneration++;
+}
+
+void SpeechDispatcher::scheduleReconnect()
+{
+    // Full delay +/- 25% so that clients restarted together don't retry together
+    guint delay = m_reconnectDelayMs;
+    gint32 jitter = delay / 4;
+    delay += g_random_int_range(-jitter, jitter + 1);
+
+    setConnectionState(CONNECTION_BACKOFF);
+    RDKLOG_INFO("Reconnecting the speech sink in %ums", delay);
+    g_source_set_ready_time(m_reconnectSource, g_get_monotonic_time() + (gint64)delay * 1000);
+
+    m_reconnectDelayMs = MIN(m_reconnectDelayMs * 2, m_reconnectMaxMs);
+}
+
+void SpeechDispatcher::updateReadiness()
+{
+    bool ready = m_process && m_sessionOpen && m_sink && m_sink->isActive();
+    if(ready == m_ready.load(std::memory_order_relaxed))
+        return;
+
+    m_ready = ready;
+    if(ready) {
+        if(m_readySince) {
+            m_timeToReadyUs = g_get_monotonic_time() - m_readySince;
+            RDKLOG_INFO("Speech is ready after %lldms", (long long)m_timeToReadyUs.load() / 1000);
+        }
+        m_readySince = 0;
+        g_source_set_ready_time(m_holdSource, -1);
+        speakNext();
+    } else {
+        RDKLOG_INFO("Speech is not ready");
+        if(m_process)
+            m_readySince = g_get_monotonic_time();
+    }
+}
+
+void SpeechDispatcher::setConnectionState(ConnectionState state)
+{
+    m_connectionState.store(state, std::memory_order_relaxed);
+}
+
+gboolean SpeechDispatcher::HoldDispatch(GSource *source, GSourceFunc, gpointer)
+{
+    g_source_set_ready_time(source, -1);
+    reinterpret_cast<QueueSource*>(source)->dispatcher->speakNext();
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean SpeechDispatcher::ReconnectDispatch(GSource *source, GSourceFunc, gpointer)
+{
+    g_source_set_ready_time(source, -1);
+    SpeechDispatcher *self = reinterpret_cast<QueueSource*>(source)->dispatcher;
+    switch(self->connectionState()) {
+    case CONNECTION_CONNECTING:
+        RDKLOG_ERROR("The %s speech sink didn't connect within %ums", self->m_sink->name(), self->m_connectTimeoutMs);
+        self->dropSink();
+        self->scheduleReconnect();
+        break;
+    case CONNECTION_BACKOFF:
+        self->connectSink();
+        break;
+    default:
+        break;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void SpeechDispatcher::createOrDestroySession()
+{
+    if(!m_sink)
+        return;
+
+    if(m_process) {
+        if(!m_sessionOpen && m_shouldCreateSession) {
+            m_sessionOpen = m_sink->openSession();
+        }
+    } else {
+        if(m_sessionOpen) {
+            m_ducking.release();
+            m_sink->closeSession();
+            m_sessionOpen = false;
+        }
+    }
+    m_shouldCreateSession = false;
+}
+
+void SpeechDispatcher::schedule(Command &cmd)
+{
+    ScheduledSpeech speech;
+    speech.text = std::move(cmd.text);
+    speech.priority = cmd.priority;
+    speech.eventNs = cmd.eventNs;
+    speech.composedNs = cmd.timestampNs;
+    speech.enqueueTime = cmd.enqueueTime;
+
+    if(m_scheduler.push(speech, m_speaking, m_currentPriority)) {
+        RDKLOG_VERBOSE("Interrupting speechid=%d for %s speech", m_speechId, speechPriorityName(cmd.priority));
+        if(m_sessionOpen)
+            m_sink->abort();
+        m_speaking = false;
+    }
+    speakNext();
+}
+
+void SpeechDispatcher::speakNext()
+{
+    // Kept for when the connection is back, unless there never was TTS to say it
+    bool holding = connectionState() != CONNECTION_CONNECTED && m_everConnected && ttsEnabled();
+
+    // Shortly after enabling, wait for the session rather than dropping speech
+    if(!holding && !m_ready && m_process && !m_scheduler.empty()) {
+        gint64 now = g_get_monotonic_time();
+        if(now < m_holdUntil) {
+            g_source_set_ready_time(m_holdSource, m_holdUntil);
+            holding = true;
+        }
+    }
+
+    ScheduledSpeech speech;
+    while(!holding && !m_speaking && m_scheduler.pop(speech))
+        doSpeak(speech);
+
+    if(!m_speaking)
+        m_ducking.idle();
+}
+
+void SpeechDispatcher::doSpeak(ScheduledSpeech &speech)
+{
+    gint64 latency = g_get_monotonic_time() - speech.enqueueTime;
+    m_lastLatencyUs = latency;
+    m_totalLatencyUs += latency;
+    if(latency > m_maxLatencyUs.load(std::memory_order_relaxed))
+        m_maxLatencyUs = latency;
+
+    if(!m_sink) {
+        RDKLOG_INFO("Text to Speak : \"%s\"", speech.text.c_str());
+        return;
+    }
+
+    if(!m_sessionOpen || !m_sink->isActive()) {
+        RDKLOG_WARNING("Session has not acquired resource to speak");
+        return;
+    }
+
+    m_ducking.duck();
+
+    uint32_t id = ++m_speechId;
+    if(id == 0)
+        id = ++m_speechId; // 0 marks an unused InFlight slot
+    m_current = speech;
+    uint64_t start = stat_now_ns();
+    bool spoken = m_sink->speak(id, speech.text);
+    uint64_t end = stat_now_ns();
+    m_latency.sinkCall.record(end - start);
+    if(!spoken) {
+        RDKLOG_WARNING("speechid=%d was rejected by the %s sink", id, m_sink->name());
+        return;
+    }
+    m_speaking = true;
+    m_currentPriority = speech.priority;
+    m_spoken++;
+
+    m_latency.accessibility.record(speech.composedNs - speech.eventNs);
+    m_latency.dispatch.record(start - speech.composedNs);
+    InFlight &f = m_inFlight[id % kMaxInFlight];
+    f.speechId = id;
+    f.eventNs = speech.eventNs;
+    f.sinkReturnNs = end;
+    f.startNs = 0;
+
+    RDKLOG_VERBOSE("speechid=%d queued for %lldus", id, (long long)latency);
+}
+
+void SpeechDispatcher::speechStarted(Command &cmd)
+{
+    InFlight &f = m_inFlight[cmd.speechId % kMaxInFlight];
+    if(f.speechId != cmd.speechId || f.startNs)
+        return;
+
+    f.startNs = cmd.timestampNs;
+    m_latency.synthesis.record(f.startNs - f.sinkReturnNs);
+    m_latency.firstAudio.record(f.startNs - f.eventNs);
+    RDKLOG_VERBOSE("speechid=%d first audio %lluus after its event", cmd.speechId,
+        (unsigned long long)(f.startNs - f.eventNs) / 1000);
+}
+
+void SpeechDispatcher::speechFinished(Command &cmd)
+{
+    InFlight &f = m_inFlight[cmd.speechId % kMaxInFlight];
+    if(f.speechId != cmd.speechId)
+        return;
+
+    if(f.startNs && cmd.result == SPEECH_COMPLETED)
+        m_latency.playback.record(cmd.timestampNs - f.startNs);
+    f.speechId = 0;
+}
+
+void SpeechDispatcher::speak(const std::string &text, SpeechPriority priority, uint64_t eventNs)
+{
+    Command cmd = {};
+    cmd.type = CMD_SPEAK;
+    cmd.text = text;
+    cmd.priority = priority;
+    cmd.eventNs = eventNs;
+    cmd.timestampNs = stat_now_ns();
+    cmd.enqueueTime = g_get_monotonic_time();
+    post(cmd);
+}
+
+void SpeechDispatcher::abort()
+{
+    Command cmd = {};
+    cmd.type = CMD_ABORT;
+    post(cmd);
+}
+
+void SpeechDispatcher::enableProcessing(bool enable)
+{
+    Command cmd = {};
+    cmd.type = CMD_ENABLE_PROCESSING;
+    cmd.enable = enable;
+    post(cmd);
+}
+
+void SpeechDispatcher::setVolumeControlCallback(MediaVolumeControlCallback cb, void *data)
+{
+    Command cmd = {};
+    cmd.type = CMD_SET_VOLUME_CALLBACK;
+    cmd.volumeCB = cb;
+    cmd.volumeCBData = data;
+    post(cmd);
+}
+
+void SpeechDispatcher::onSinkConnected()
+{
+    Command cmd = {};
+    cmd.type = CMD_SERVER_CONNECTED;
+    notify(cmd);
+}
+
+void SpeechDispatcher::onSinkClosed()
+{
+    Command cmd = {};
+    cmd.type = CMD_SERVER_CLOSED;
+    notify(cmd);
+}
+
+void SpeechDispatcher::onSinkStateChanged(bool enabled)
+{
+    m_ttsEnabled = enabled;
+    RDKLOG_INFO("TTS is %s", enabled ? "enabled" : "disabled");
+
+    if(m_stateCB)
+        m_stateCB(enabled, m_stateCBData);
+
+    Command cmd = {};
+    cmd.type = CMD_READINESS_CHANGED;
+    notify(cmd);
+}
+
+void SpeechDispatcher::onSessionReady()
+{
+    Command cmd = {};
+    cmd.type = CMD_READINESS_CHANGED;
+    notify(cmd);
+}
+
+void SpeechDispatcher::onSpeechStarted(uint32_t speechId)
+{
+    Command cmd = {};
+    cmd.type = CMD_SPEECH_STARTED;
+    cmd.speechId = speechId;
+    cmd.timestampNs = stat_now_ns();
+    notify(cmd);
+}
+
+void SpeechDispatcher::onSpeechFinished(uint32_t speechId, SpeechResult result)
+{
+    Command cmd = {};
+    cmd.type = CMD_SPEECH_DONE;
+    cmd.speechId = speechId;
+    cmd.result = result;
+    cmd.timestampNs = stat_now_ns();
+    notify(cmd);
+}
+
+gboolean SpeechDispatcher::QueuePrepare(GSource *source, gint *timeout)
+{
+    *timeout = -1;
+    return reinterpret_cast<QueueSource*>(source)->dispatcher->m_pending.load() > 0;
+}
+
+gboolean SpeechDispatcher::QueueCheck(GSource *source)
+{
+    return reinterpret_cast<QueueSource*>(source)->dispatcher->m_pending.load() > 0;
+}
+
+gboolean SpeechDispatcher::QueueDispatch(GSource *source, GSourceFunc, gpointer)
+{
+    reinterpret_cast<QueueSource*>(source)->dispatcher->drain();
+    return G_SOURCE_CONTINUE;
+}
+
+} // namespace RDK_AT
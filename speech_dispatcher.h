@@ -0,0 +1,273 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_SPEECH_DISPATCHER_H
+#define RDK_AT_SPEECH_DISPATCHER_H
+
+#include "rdkat.h"
+#include "speech_sink.h"
+#include "speech_scheduler.h"
+#include "ducking_controller.h"
+#include "statistics.h"
+#include "mpsc_queue.h"
+
+#include <glib.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Distribution of the time spent in each stage of an utterance.
+ * Stages are consecutive, firstAudio spans all the ones before playback.
+ */
+struct SpeechLatency {
+    LatencyHistogram accessibility; // event received -> text composed (coalescing, ATK queries)
+    LatencyHistogram dispatch;      // text composed -> handed to the sink (thread hop, scheduling)
+    LatencyHistogram sinkCall;      // SpeechSink::speak() call (TTS IPC)
+    LatencyHistogram synthesis;     // sink call returned -> speech started
+    LatencyHistogram playback;      // speech started -> completed, interrupted ones excluded
+    LatencyHistogram firstAudio;    // event received -> speech started
+};
+
+enum ConnectionState {
+    CONNECTION_IDLE,        // not requested yet
+    CONNECTION_CONNECTING,  // waiting for the sink to report it is connected
+    CONNECTION_CONNECTED,
+    CONNECTION_BACKOFF      // waiting for the next attempt
+};
+
+const char* connectionStateName(ConnectionState state);
+
+/**
+ * @brief Owns the speech sink, its session and all the traffic to it.
+ *
+ * Requests from the ATK thread are queued and handled on a dedicated thread
+ * running its own GMainContext, so that an event handler never waits for a
+ * TTSManager round trip. Sink notifications are funneled through the same
+ * queue, hence session & volume state are only ever touched by the dispatcher
+ * thread. The queue is lock-free, posting never waits on the other thread.
+ * The sink is picked by RDKAT_SPEECH_SINK, see createSpeechSink().
+ *
+ * Utterances waiting in the queue are bounded (RDKAT_SPEECH_QUEUE_SIZE,
+ * default 8) when posted, so that the queue can't grow while the dispatcher
+ * thread is blocked in the sink; on overflow the new utterance is dropped.
+ * Utterances are then handed to the sink one at a time, in the order given by
+ * the SpeechScheduler.
+ *
+ * The sink is connected from start(), in the background, so that the first
+ * utterance doesn't pay for it; the session is opened on EnableProcessing(true).
+ * Speech requested before the session is ready is held for up to
+ * RDKAT_SPEECH_HOLD_MS (default 2000) after enabling. When the sink can't
+ * be or the connection is lost, it is recreated from a timer with
+ * exponential backoff and jitter (RDKAT_RECONNECT_MIN_MS, default 250, up to
+ * RDKAT_RECONNECT_MAX_MS, default 30000). Meanwhile only the latest focus or
+ * state utterance is kept, it is spoken once a session is back. A connection
+ * the sink doesn't confirm within RDKAT_SPEECH_CONNECT_TIMEOUT_MS (default
+ * 5000) counts as failed; notifications from a sink replaced since are ignored.
+ *
+ * Each utterance is timestamped from the event it originates from until the
+ * sink reports its completion, see SpeechLatency.
+ */
+class SpeechDispatcher : public SpeechSinkListener {
+public:
+    // Invoked on the sink's thread whenever TTS gets enabled / disabled
+    typedef void (*TTSStateCallback)(bool enabled, void *data);
+
+    SpeechDispatcher();
+    ~SpeechDispatcher();
+
+    void start(TTSStateCallback cb, void *data);
+    void stop();
+
+    // Called from the ATK thread, these never block on TTSManager
+    void speak(const std::string &text, SpeechPriority priority, uint64_t eventNs); // eventNs from stat_now_ns()
+    void abort(); // focus moved, drops & interrupts the speech about the previous element
+    void enableProcessing(bool enable);
+    void setVolumeControlCallback(MediaVolumeControlCallback cb, void *data);
+
+    bool ttsEnabled() const { return m_ttsEnabled.load(std::memory_order_relaxed); }
+    bool ready() const { return m_ready.load(std::memory_order_relaxed); } // the session may speak
+    gint64 timeToReadyUs() const { return m_timeToReadyUs.load(std::memory_order_relaxed); }
+
+    // Observability
+    size_t queueDepth() const { return m_queuedSpeech.load(std::memory_order_relaxed); }
+    size_t maxQueueDepth() const { return m_maxQueuedSpeech.load(std::memory_order_relaxed); }
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t spokenCount() const { return m_spoken.load(std::memory_order_relaxed); }
+    uint64_t abortedCount() const { return m_aborted.load(std::memory_order_relaxed); }
+    gint64 lastLatencyUs() const { return m_lastLatencyUs.load(std::memory_order_relaxed); }
+    gint64 maxLatencyUs() const { return m_maxLatencyUs.load(std::memory_order_relaxed); }
+    gint64 totalLatencyUs() const { return m_totalLatencyUs.load(std::memory_order_relaxed); }
+    const SpeechLatency& latency() const { return m_latency; }
+    const SpeechScheduler& scheduler() const { return m_scheduler; }
+    const DuckingController& ducking() const { return m_ducking; }
+    ConnectionState connectionState() const { return (ConnectionState)m_connectionState.load(std::memory_order_relaxed); }
+    uint64_t connectAttempts() const { return m_connectAttempts; }
+    uint64_t disconnects() const { return m_disconnects; }
+    uint64_t reconnects() const { return m_reconnects; }
+
+    // SpeechSinkListener
+    virtual void onSinkConnected();
+    virtual void onSinkClosed();
+    virtual void onSinkStateChanged(bool enabled);
+    virtual void onSessionReady();
+    virtual void onSpeechStarted(uint32_t speechId);
+    virtual void onSpeechFinished(uint32_t speechId, SpeechResult result);
+
+private:
+    SpeechDispatcher(const SpeechDispatcher &);
+    SpeechDispatcher& operator=(const SpeechDispatcher &);
+
+    enum CommandType {
+        CMD_CONNECT,
+        CMD_SPEAK,
+        CMD_ENABLE_PROCESSING,
+        CMD_SET_VOLUME_CALLBACK,
+        CMD_SERVER_CONNECTED,
+        CMD_SERVER_CLOSED,
+        CMD_READINESS_CHANGED,
+        CMD_SPEECH_STARTED,
+        CMD_SPEECH_DONE,
+        CMD_ABORT,
+        CMD_QUIT
+    };
+
+    struct Command {
+        CommandType type;
+        bool enable;
+        std::string text;
+        uint32_t speechId;
+        SpeechPriority priority;
+        SpeechResult result;
+        uint64_t eventNs;
+        uint64_t timestampNs; // composition for CMD_SPEAK, sink notification otherwise
+        uint32_t sinkGeneration; // of the sink a notification comes from, 0 for requests
+        gint64 enqueueTime;
+        MediaVolumeControlCallback volumeCB;
+        void *volumeCBData;
+    };
+
+    // Timestamps of an utterance handed to the sink
+    struct InFlight {
+        uint32_t speechId; // 0 when unused
+        uint64_t eventNs;
+        uint64_t sinkReturnNs;
+        uint64_t startNs;
+    };
+    enum { kMaxInFlight = 16 };
+
+    struct QueueSource {
+        GSource source;
+        SpeechDispatcher *dispatcher;
+    };
+
+    void post(Command &cmd);
+    void notify(Command &cmd); // posts a sink notification
+    void drain();
+    void prune(std::vector<Command> &batch);
+    void handle(Command &cmd);
+    void run();
+
+    // Dispatcher thread only
+    void ensureSinkConnection();
+    void connectSink();
+    void dropSink();
+    void scheduleReconnect();
+    void setConnectionState(ConnectionState state);
+    void updateReadiness();
+    void createOrDestroySession();
+    void schedule(Command &cmd);
+    void speakNext();
+    void doSpeak(ScheduledSpeech &speech);
+    void speechStarted(Command &cmd);
+    void speechFinished(Command &cmd);
+
+    static gboolean QueuePrepare(GSource *source, gint *timeout);
+    static gboolean QueueCheck(GSource *source);
+    static gboolean QueueDispatch(GSource *source, GSourceFunc, gpointer);
+    static GSourceFuncs s_queueSourceFuncs;
+    static gboolean ReconnectDispatch(GSource *source, GSourceFunc, gpointer);
+    static GSourceFuncs s_reconnectSourceFuncs;
+    static gboolean HoldDispatch(GSource *source, GSourceFunc, gpointer);
+    static GSourceFuncs s_holdSourceFuncs;
+
+    GMainContext *m_context;
+    GMainLoop *m_loop;
+    GSource *m_queueSource;
+    GSource *m_reconnectSource;
+    GSource *m_holdSource;
+    std::thread m_thread;
+
+    MpscQueue<Command> m_queue;
+    std::atomic<size_t> m_pending;
+    size_t m_capacity;
+    std::vector<Command> m_batch; // dispatcher thread, what drain() took from the queue
+
+    TTSStateCallback m_stateCB;
+    void *m_stateCBData;
+    std::atomic<bool> m_ttsEnabled;
+
+    // Owned by the dispatcher thread
+    bool m_process;
+    bool m_shouldCreateSession;
+    bool m_sessionOpen;
+    uint32_t m_speechId;
+    SpeechSink *m_sink;
+    std::atomic<uint32_t> m_sinkGeneration; // bumped once a sink is deleted
+    guint m_reconnectMinMs;
+    guint m_reconnectMaxMs;
+    guint m_reconnectDelayMs;
+    guint m_connectTimeoutMs;
+    bool m_everConnected;
+    guint m_holdMs;
+    gint64 m_holdUntil;     // speech waits for the session until then
+    gint64 m_readySince;    // when readiness was last requested, 0 once ready
+    bool m_speaking;
+    SpeechPriority m_currentPriority;
+    ScheduledSpeech m_current; // replayed if the connection is lost while it is spoken
+    SpeechScheduler m_scheduler;
+    DuckingController m_ducking;
+
+    std::atomic<int> m_connectionState;
+    std::atomic<bool> m_ready;
+    std::atomic<gint64> m_timeToReadyUs;
+    StatCounter m_connectAttempts;
+    StatCounter m_disconnects;
+    StatCounter m_reconnects;
+
+    std::atomic<size_t> m_queuedSpeech;
+    std::atomic<size_t> m_maxQueuedSpeech;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_spoken;
+    std::atomic<uint64_t> m_aborted;
+    std::atomic<gint64> m_lastLatencyUs;
+    std::atomic<gint64> m_maxLatencyUs;
+    std::atomic<gint64> m_totalLatencyUs;
+    InFlight m_inFlight[kMaxInFlight]; // indexed by speech id
+    SpeechLatency m_latency;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_SPEECH_DISPATCHER_H
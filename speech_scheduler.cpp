@@ -0,0 +1,135 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "speech_scheduler.h"
+#include "logger.h"
+
+namespace RDK_AT
+{
+
+struct SchedulingRule {
+    const char *name;
+    bool interrupt;     // interrupts speech of the same or a lower priority
+    bool replace;       // supersedes the pending utterances of the class
+    bool focusBound;    // dropped when focus moves
+    size_t capacity;
+};
+
+static const SchedulingRule kRules[SPEECH_PRIORITY_COUNT] = {
+    { "focus",    true,  true,  true,  1 },
+    { "state",    true,  true,  true,  2 },
+    { "document", false, false, false, 2 },
+    { "live",     false, false, false, 4 }
+};
+
+const char* speechPriorityName(SpeechPriority priority)
+{
+    return kRules[priority].name;
+}
+
+bool speechPriorityFocusBound(SpeechPriority priority)
+{
+    return kRules[priority].focusBound;
+}
+
+SpeechScheduler::SpeechScheduler() :
+    m_size(0),
+    m_replaced(0),
+    m_overflowed(0),
+    m_interrupts(0),
+    m_stale(0)
+{
+}
+
+bool SpeechScheduler::push(ScheduledSpeech &speech, bool speaking, SpeechPriority current)
+{
+    const SchedulingRule &rule = kRules[speech.priority];
+    std::deque<ScheduledSpeech> &pending = m_pending[speech.priority];
+
+    if(rule.replace && !pending.empty()) {
+        m_replaced += pending.size();
+        m_size = m_size - pending.size();
+        pending.clear();
+    }
+
+    if(pending.size() >= rule.capacity) {
+        RDKLOG_WARNING("Too much %s speech pending, dropping \"%s\"", rule.name, pending.front().text.c_str());
+        pending.pop_front();
+        m_overflowed++;
+        m_size = m_size - 1;
+    }
+
+    pending.push_back(std::move(speech));
+    m_size++;
+
+    bool interrupt = speaking && rule.interrupt && current >= pending.back().priority;
+    if(interrupt)
+        m_interrupts++;
+    return interrupt;
+}
+
+bool SpeechScheduler::pop(ScheduledSpeech &speech)
+{
+    for(int i = 0; i < SPEECH_PRIORITY_COUNT; i++) {
+        if(!m_pending[i].empty()) {
+            speech = std::move(m_pending[i].front());
+            m_pending[i].pop_front();
+            m_size = m_size - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SpeechScheduler::dropFocusBound()
+{
+    for(int i = 0; i < SPEECH_PRIORITY_COUNT; i++) {
+        if(speechPriorityFocusBound((SpeechPriority)i) && !m_pending[i].empty()) {
+            m_stale += m_pending[i].size();
+            m_size = m_size - m_pending[i].size();
+            m_pending[i].clear();
+        }
+    }
+}
+
+void SpeechScheduler::keepLatestFocusBound()
+{
+    bool kept = false;
+    for(int i = 0; i < SPEECH_PRIORITY_COUNT; i++) {
+        std::deque<ScheduledSpeech> &pending = m_pending[i];
+        if(!kept && !pending.empty() && speechPriorityFocusBound((SpeechPriority)i)) {
+            m_stale += pending.size() - 1;
+            pending.erase(pending.begin(), pending.end() - 1);
+            kept = true;
+        } else {
+            m_stale += pending.size();
+            pending.clear();
+        }
+    }
+    m_size = kept ? 1 : 0;
+}
+
+void SpeechScheduler::clear()
+{
+    for(int i = 0; i < SPEECH_PRIORITY_COUNT; i++)
+        m_pending[i].clear();
+    m_size = 0;
+}
+
+} // namespace RDK_AT
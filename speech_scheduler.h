@@ -0,0 +1,96 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_SPEECH_SCHEDULER_H
+#define RDK_AT_SPEECH_SCHEDULER_H
+
+#include "statistics.h"
+
+#include <glib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <string>
+
+namespace RDK_AT
+{
+
+// Highest priority first
+enum SpeechPriority {
+    SPEECH_PRIORITY_FOCUS,
+    SPEECH_PRIORITY_STATE,      // state change of the focused element
+    SPEECH_PRIORITY_DOCUMENT,   // document & window notifications
+    SPEECH_PRIORITY_LIVE,       // live updates
+    SPEECH_PRIORITY_COUNT
+};
+
+const char* speechPriorityName(SpeechPriority priority);
+bool speechPriorityFocusBound(SpeechPriority priority); // about the focused element
+
+struct ScheduledSpeech {
+    std::string text;
+    SpeechPriority priority;
+    uint64_t eventNs;
+    uint64_t composedNs;
+    gint64 enqueueTime;
+};
+
+/**
+ * @brief Orders pending utterances by priority class.
+ *
+ * Per class rules tell whether a new utterance interrupts the one being
+ * spoken, replaces the pending ones of its class and how many may be
+ * pending; on overflow the oldest of the class is dropped. Within a class
+ * utterances keep their arrival order.
+ *
+ * Only to be used from the speech dispatcher thread, counters excepted.
+ */
+class SpeechScheduler {
+public:
+    SpeechScheduler();
+
+    // Returns true if the utterance being spoken, of priority current, is to be interrupted
+    bool push(ScheduledSpeech &speech, bool speaking, SpeechPriority current);
+    bool pop(ScheduledSpeech &speech);
+    void dropFocusBound(); // focus moved, what was pending about the previous element is stale
+    void keepLatestFocusBound(); // only the most recent, most urgent focus bound utterance is kept
+    void clear();
+
+    bool empty() const { return m_size == 0; }
+    uint64_t size() const { return m_size; }
+    uint64_t replacedCount() const { return m_replaced; }
+    uint64_t overflowCount() const { return m_overflowed; }
+    uint64_t interruptCount() const { return m_interrupts; }
+    uint64_t staleCount() const { return m_stale; }
+
+private:
+    SpeechScheduler(const SpeechScheduler &);
+    SpeechScheduler& operator=(const SpeechScheduler &);
+
+    std::deque<ScheduledSpeech> m_pending[SPEECH_PRIORITY_COUNT];
+    StatCounter m_size;
+    StatCounter m_replaced;
+    StatCounter m_overflowed;
+    StatCounter m_interrupts;
+    StatCounter m_stale;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_SPEECH_SCHEDULER_H
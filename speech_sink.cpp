@@ -0,0 +1,218 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "speech_sink.h"
+#include "tts_speech_sink.h"
+#include "logger.h"
+
+#include <errno.h>
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Completes every utterance as soon as it is handed over.
+ */
+class NullSpeechSink : public SpeechSink {
+public:
+    NullSpeechSink() : m_listener(NULL), m_session(false) {}
+
+    const char* name() const { return "null"; }
+
+    bool connect(SpeechSinkListener *listener)
+    {
+        m_listener = listener;
+        m_listener->onSinkConnected();
+        m_listener->onSinkStateChanged(true);
+        return true;
+    }
+
+    bool openSession() { m_session = true; m_listener->onSessionReady(); return true; }
+    void closeSession() { m_session = false; }
+    bool isActive() { return m_session; }
+
+    bool speak(uint32_t speechId, std::string &text)
+    {
+        if(!consume(speechId, text))
+            return false;
+        m_listener->onSpeechStarted(speechId);
+        m_listener->onSpeechFinished(speechId, SPEECH_COMPLETED);
+        return true;
+    }
+
+    void abort() {}
+
+protected:
+    virtual bool consume(uint32_t, const std::string &) { return m_session; }
+
+    SpeechSinkListener *m_listener;
+    bool m_session;
+};
+
+/**
+ * @brief Records utterances, one line each, and completes them at once.
+ */
+class FileSpeechSink : public NullSpeechSink {
+public:
+    explicit FileSpeechSink(const char *path) : m_path(path), m_file(NULL) {}
+    ~FileSpeechSink() { if(m_file) fclose(m_file); }
+
+    const char* name() const { return "file"; }
+
+    bool connect(SpeechSinkListener *listener)
+    {
+        m_file = fopen(m_path.c_str(), "a");
+        if(!m_file) {
+            RDKLOG_ERROR("Unable to open speech file \"%s\": %s", m_path.c_str(), strerror(errno));
+            return false;
+        }
+        setvbuf(m_file, NULL, _IOLBF, 0);
+        return NullSpeechSink::connect(listener);
+    }
+
+protected:
+    bool consume(uint32_t speechId, const std::string &text)
+    {
+        if(!m_session)
+            return false;
+        fprintf(m_file, "%lld %u %s\n", (long long)g_get_monotonic_time(), speechId, text.c_str());
+        return true;
+    }
+
+private:
+    std::string m_path;
+    FILE *m_file;
+};
+
+/**
+ * @brief Plays utterances for a duration proportional to their length,
+ * timed on the caller's thread default GMainContext.
+ */
+class LoopbackSpeechSink : public SpeechSink {
+public:
+    explicit LoopbackSpeechSink(guint msPerChar) :
+        m_listener(NULL), m_context(NULL), m_timer(NULL),
+        m_msPerChar(msPerChar), m_speechId(0), m_session(false) {}
+
+    ~LoopbackSpeechSink()
+    {
+        cancel();
+        if(m_context)
+            g_main_context_unref(m_context);
+    }
+
+    const char* name() const { return "loopback"; }
+
+    bool connect(SpeechSinkListener *listener)
+    {
+        m_listener = listener;
+        m_context = g_main_context_ref_thread_default();
+        m_listener->onSinkConnected();
+        m_listener->onSinkStateChanged(true);
+        return true;
+    }
+
+    bool openSession() { m_session = true; m_listener->onSessionReady(); return true; }
+    void closeSession() { abort(); m_session = false; }
+    bool isActive() { return m_session; }
+
+    bool speak(uint32_t speechId, std::string &text)
+    {
+        if(!m_session)
+            return false;
+
+        // A new utterance interrupts the current one, like TTSManager does
+        abort();
+
+        m_speechId = speechId;
+        m_timer = g_timeout_source_new(m_msPerChar * text.size());
+        g_source_set_callback(m_timer, Finished, this, NULL);
+        g_source_attach(m_timer, m_context);
+        m_listener->onSpeechStarted(speechId);
+        return true;
+    }
+
+    void abort()
+    {
+        if(cancel())
+            m_listener->onSpeechFinished(m_speechId, SPEECH_INTERRUPTED);
+    }
+
+private:
+    bool cancel()
+    {
+        if(!m_timer)
+            return false;
+        g_source_destroy(m_timer);
+        g_source_unref(m_timer);
+        m_timer = NULL;
+        return true;
+    }
+
+    static gboolean Finished(gpointer data)
+    {
+        LoopbackSpeechSink *self = static_cast<LoopbackSpeechSink*>(data);
+        g_source_unref(self->m_timer);
+        self->m_timer = NULL;
+        self->m_listener->onSpeechFinished(self->m_speechId, SPEECH_COMPLETED);
+        return G_SOURCE_REMOVE;
+    }
+
+    SpeechSinkListener *m_listener;
+    GMainContext *m_context;
+    GSource *m_timer;
+    guint m_msPerChar;
+    uint32_t m_speechId;
+    bool m_session;
+};
+
+SpeechSink* createSpeechSink()
+{
+    const char *spec = getenv("RDKAT_SPEECH_SINK");
+    if(!spec || !*spec)
+        spec = "tts";
+
+    const char *arg = strchr(spec, ':');
+    size_t len = arg ? (size_t)(arg - spec) : strlen(spec);
+    if(arg)
+        arg++;
+
+    SpeechSink *sink = NULL;
+    if(len == 4 && strncmp(spec, "null", len) == 0) {
+        sink = new NullSpeechSink();
+    } else if(len == 4 && strncmp(spec, "file", len) == 0) {
+        sink = new FileSpeechSink(arg && *arg ? arg : "/tmp/rdkat-speech.log");
+    } else if(len == 8 && strncmp(spec, "loopback", len) == 0) {
+        int ms = arg ? atoi(arg) : 0;
+        sink = new LoopbackSpeechSink(ms > 0 ? ms : 60);
+    } else {
+        if(len != 3 || strncmp(spec, "tts", len) != 0)
+            RDKLOG_WARNING("Unknown speech sink \"%s\", using tts", spec);
+        sink = new TTSSpeechSink();
+    }
+
+    RDKLOG_INFO("Speech sink : %s", sink->name());
+    return sink;
+}
+
+} // namespace RDK_AT
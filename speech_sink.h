@@ -0,0 +1,86 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_SPEECH_SINK_H
+#define RDK_AT_SPEECH_SINK_H
+
+#include <stdint.h>
+
+#include <string>
+
+namespace RDK_AT
+{
+
+enum SpeechResult {
+    SPEECH_COMPLETED,
+    SPEECH_INTERRUPTED,
+    SPEECH_CANCELLED,
+    SPEECH_FAILED
+};
+
+/**
+ * @brief Receives the notifications of a SpeechSink.
+ * May be invoked from any thread, including from within a sink call.
+ */
+class SpeechSinkListener {
+public:
+    virtual ~SpeechSinkListener() {}
+    virtual void onSinkConnected() = 0;
+    virtual void onSinkClosed() = 0;
+    virtual void onSinkStateChanged(bool enabled) = 0;
+    virtual void onSessionReady() = 0; // the session may speak now, see SpeechSink::isActive()
+    virtual void onSpeechStarted(uint32_t speechId) = 0;
+    virtual void onSpeechFinished(uint32_t speechId, SpeechResult result) = 0;
+};
+
+/**
+ * @brief Where utterances end up.
+ *
+ * connect() is asynchronous, the sink reports onSinkConnected() and its
+ * enabled state once it can be used. All calls are made from a single
+ * thread, the speech dispatcher's.
+ */
+class SpeechSink {
+public:
+    virtual ~SpeechSink() {}
+
+    virtual const char* name() const = 0;
+
+    virtual bool connect(SpeechSinkListener *listener) = 0;
+    virtual bool openSession() = 0;
+    virtual void closeSession() = 0;   // no-op when no session is open
+    virtual bool isActive() = 0;       // the session may speak now
+
+    // text may be moved from
+    virtual bool speak(uint32_t speechId, std::string &text) = 0;
+    virtual void abort() = 0;
+};
+
+/**
+ * @brief Creates the sink selected by RDKAT_SPEECH_SINK
+ *   "tts" (default)      TTSManager through TTS::TTSClient
+ *   "null"               drops utterances, completing them at once
+ *   "file[:path]"        appends utterances to a file (default /tmp/rdkat-speech.log)
+ *   "loopback[:ms]"      completes utterances after ms per character (default 60)
+ * The in-process sinks report TTS as enabled.
+ */
+SpeechSink* createSpeechSink();
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_SPEECH_SINK_H
@@ -0,0 +1,140 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "statistics.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+namespace RDK_AT
+{
+
+ListenerTimer *ListenerTimer::s_current = NULL;
+
+static const char *const kListenerStatNames[LISTENER_STAT_COUNT] = {
+    "PropertyEventListener",
+    "StateEventListener",
+    "WindowEventListener",
+    "DocumentEventListener",
+    "BoundsEventListener",
+    "ActiveDescendantEventListener",
+    "LinkSelectedEventListener",
+    "TextChangedEventListener",
+    "TextInsertEventListener",
+    "TextRemoveEventListener",
+    "ChildrenChangedEventListener",
+    "GenericEventListener",
+    "FocusTracker"
+};
+
+const char* listenerStatName(ListenerStat listener)
+{
+    return kListenerStatNames[listener];
+}
+
+void StatsWriter::key(const char *name)
+{
+    if(!m_out.empty()) {
+        char last = m_out[m_out.size() - 1];
+        if(last != '{' && last != '[')
+            m_out += ',';
+    }
+    if(name) {
+        m_out += '"';
+        m_out += name;
+        m_out += "\":";
+    }
+}
+
+void StatsWriter::beginObject(const char *name)
+{
+    key(name);
+    m_out += '{';
+}
+
+void StatsWriter::endObject()
+{
+    m_out += '}';
+}
+
+void StatsWriter::field(const char *name, uint64_t value)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%" PRIu64, value);
+    key(name);
+    m_out += buf;
+}
+
+void StatsWriter::field(const char *name, int64_t value)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%" PRId64, value);
+    key(name);
+    m_out += buf;
+}
+
+void StatsWriter::field(const char *name, const char *value)
+{
+    // Only ever given identifiers, nothing to escape
+    key(name);
+    m_out += '"';
+    m_out += value;
+    m_out += '"';
+}
+
+void StatsWriter::field(const char *name, bool value)
+{
+    key(name);
+    m_out += value ? "true" : "false";
+}
+
+void StatsWriter::histogram(const char *name, const LatencyHistogram &histogram)
+{
+    beginObject(name);
+    field("count", histogram.count());
+    field("total_ns", histogram.total());
+    field("max_ns", histogram.max());
+
+    // Trailing empty buckets are left out
+    int last = LatencyHistogram::kBuckets - 1;
+    while(last >= 0 && histogram.bucket(last) == 0)
+        last--;
+
+    key("log2_ns_buckets");
+    m_out += '[';
+    for(int i = 0; i <= last; i++) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), i ? ",%" PRIu64 : "%" PRIu64, histogram.bucket(i));
+        m_out += buf;
+    }
+    m_out += ']';
+    endObject();
+}
+
+void StatsWriter::listener(const char *name, const ListenerStats &stats)
+{
+    beginObject(name);
+    field("invocations", stats.invocations.get());
+    field("dropped", stats.dropped.get());
+    field("total_ns", stats.totalNs.get());
+    field("max_ns", stats.maxNs.get());
+    endObject();
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,200 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_STATISTICS_H
+#define RDK_AT_STATISTICS_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <atomic>
+#include <string>
+
+namespace RDK_AT
+{
+
+inline uint64_t stat_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Counter with a single writing thread, readable from any thread.
+ * Updates are relaxed load + store, no locked instruction on the hot path.
+ */
+class StatCounter {
+public:
+    StatCounter(uint64_t value = 0) : m_value(value) {}
+
+    StatCounter& operator=(uint64_t value) { m_value.store(value, std::memory_order_relaxed); return *this; }
+    StatCounter& operator+=(uint64_t n) { return *this = get() + n; }
+    StatCounter& operator++() { return *this += 1; }
+    void operator++(int) { *this += 1; }
+    void raise(uint64_t value) { if(value > get()) *this = value; }
+
+    uint64_t get() const { return m_value.load(std::memory_order_relaxed); }
+    operator uint64_t() const { return get(); }
+
+private:
+    StatCounter(const StatCounter &);
+
+    std::atomic<uint64_t> m_value;
+};
+
+/**
+ * @brief log2 histogram of durations in nanoseconds, single writing thread.
+ * Bucket i counts durations below 2^(i+1) ns, the last one everything above.
+ */
+class LatencyHistogram {
+public:
+    enum { kBuckets = 32 };
+
+    void record(uint64_t ns)
+    {
+        unsigned bucket = ns > 1 ? 63 - __builtin_clzll(ns) : 0;
+        m_buckets[bucket < kBuckets ? bucket : kBuckets - 1]++;
+        m_count++;
+        m_total += ns;
+        m_max.raise(ns);
+    }
+
+    uint64_t count() const { return m_count; }
+    uint64_t total() const { return m_total; }
+    uint64_t max() const { return m_max; }
+    uint64_t bucket(unsigned i) const { return m_buckets[i]; }
+
+private:
+    StatCounter m_buckets[kBuckets];
+    StatCounter m_count;
+    StatCounter m_total;
+    StatCounter m_max;
+};
+
+/**
+ * @brief Records the lifetime of the scope into a LatencyHistogram.
+ */
+class HistogramTimer {
+public:
+    explicit HistogramTimer(LatencyHistogram &histogram) : m_histogram(histogram), m_start(stat_now_ns()) {}
+    ~HistogramTimer() { m_histogram.record(stat_now_ns() - m_start); }
+
+private:
+    HistogramTimer(const HistogramTimer &);
+    HistogramTimer& operator=(const HistogramTimer &);
+
+    LatencyHistogram &m_histogram;
+    uint64_t m_start;
+};
+
+enum ListenerStat {
+    LISTENER_STAT_PROPERTY,
+    LISTENER_STAT_STATE,
+    LISTENER_STAT_WINDOW,
+    LISTENER_STAT_DOCUMENT,
+    LISTENER_STAT_BOUNDS,
+    LISTENER_STAT_ACTIVE_DESCENDANT,
+    LISTENER_STAT_LINK_SELECTED,
+    LISTENER_STAT_TEXT_CHANGED,
+    LISTENER_STAT_TEXT_INSERT,
+    LISTENER_STAT_TEXT_REMOVE,
+    LISTENER_STAT_CHILDREN_CHANGED,
+    LISTENER_STAT_GENERIC,
+    LISTENER_STAT_FOCUS_TRACKER,
+    LISTENER_STAT_COUNT
+};
+
+const char* listenerStatName(ListenerStat listener);
+
+struct ListenerStats {
+    StatCounter invocations;
+    StatCounter dropped;   // returned before any accessibility info got fetched
+    StatCounter totalNs;
+    StatCounter maxNs;
+};
+
+/**
+ * @brief Accounts the time spent in a listener invocation to its ListenerStats.
+ * Scopes nest, dropped() applies to the innermost one.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class ListenerTimer {
+public:
+    explicit ListenerTimer(ListenerStats &stats) :
+        m_stats(stats), m_outer(s_current), m_start(stat_now_ns()), m_dropped(false)
+    {
+        s_current = this;
+    }
+
+    ~ListenerTimer()
+    {
+        uint64_t elapsed = stat_now_ns() - m_start;
+        m_stats.invocations++;
+        if(m_dropped)
+            m_stats.dropped++;
+        m_stats.totalNs += elapsed;
+        m_stats.maxNs.raise(elapsed);
+        s_current = m_outer;
+    }
+
+    static void dropped() { if(s_current) s_current->m_dropped = true; }
+    // When the innermost listener got invoked, now outside of any listener
+    static uint64_t entryTime() { return s_current ? s_current->m_start : stat_now_ns(); }
+
+private:
+    ListenerTimer(const ListenerTimer &);
+    ListenerTimer& operator=(const ListenerTimer &);
+
+    static ListenerTimer *s_current;
+
+    ListenerStats &m_stats;
+    ListenerTimer *m_outer;
+    uint64_t m_start;
+    bool m_dropped;
+};
+
+/**
+ * @brief Appends a JSON document to a string, commas are inserted as needed.
+ */
+class StatsWriter {
+public:
+    explicit StatsWriter(std::string &out) : m_out(out) {}
+
+    void beginObject(const char *name = NULL);
+    void endObject();
+    void field(const char *name, uint64_t value);
+    void field(const char *name, int64_t value);
+    void field(const char *name, const char *value);
+    void field(const char *name, bool value);
+    void histogram(const char *name, const LatencyHistogram &histogram);
+    void listener(const char *name, const ListenerStats &stats);
+
+private:
+    StatsWriter(const StatsWriter &);
+    StatsWriter& operator=(const StatsWriter &);
+
+    void key(const char *name);
+
+    std::string &m_out;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_STATISTICS_H
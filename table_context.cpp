@@ -0,0 +1,276 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "table_context.h"
+#include "logger.h"
+
+#include <stdio.h>
+
+namespace RDK_AT
+{
+
+static const guint kMaxCells = 2048;
+
+static inline std::string checkNullAndReturnStr(const char* temp) {
+    return (temp != NULL)? temp : std::string();
+}
+
+TableContext::TableContext() :
+    m_tables(g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, DestroyTableEntry)),
+    m_cells(g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, DestroyCellEntry)),
+    m_maxCells(kMaxCells),
+    m_generation(0),
+    m_lastCell(NULL),
+    m_lastTable(NULL),
+    m_lastRow(NULL),
+    m_lastRowIndex(-1),
+    m_lastColumnIndex(-1),
+    m_hits(0),
+    m_misses(0)
+{
+}
+
+TableContext::~TableContext()
+{
+    forget();
+    clear();
+    g_hash_table_destroy(m_tables);
+    g_hash_table_destroy(m_cells);
+}
+
+void TableContext::DestroyTableEntry(gpointer data)
+{
+    delete static_cast<TableEntry*>(data);
+}
+
+void TableContext::DestroyCellEntry(gpointer data)
+{
+    delete static_cast<CellEntry*>(data);
+}
+
+void TableContext::TableFinalized(gpointer data, GObject *obj)
+{
+    g_hash_table_remove(static_cast<TableContext*>(data)->m_tables, obj);
+}
+
+void TableContext::CellFinalized(gpointer data, GObject *obj)
+{
+    g_hash_table_remove(static_cast<TableContext*>(data)->m_cells, obj);
+}
+
+void TableContext::track(AtkObject **slot, AtkObject *obj)
+{
+    if(*slot == obj)
+        return;
+    if(*slot)
+        g_object_remove_weak_pointer(G_OBJECT(*slot), (gpointer*)slot);
+    *slot = obj;
+    if(obj)
+        g_object_add_weak_pointer(G_OBJECT(obj), (gpointer*)slot);
+}
+
+void TableContext::forget()
+{
+    track(&m_lastCell, NULL);
+    track(&m_lastTable, NULL);
+    track(&m_lastRow, NULL);
+    m_lastRowIndex = -1;
+    m_lastColumnIndex = -1;
+}
+
+TableContext::TableEntry* TableContext::tableEntry(AtkObject *table)
+{
+    TableEntry *entry = static_cast<TableEntry*>(g_hash_table_lookup(m_tables, table));
+    if(entry)
+        return entry;
+
+    entry = new TableEntry();
+    entry->generation = ++m_generation;
+    entry->captionResolved = false;
+    entry->rows = atk_table_get_n_rows(ATK_TABLE(table));
+    entry->columns = atk_table_get_n_columns(ATK_TABLE(table));
+
+    g_object_weak_ref(G_OBJECT(table), TableFinalized, this);
+    g_hash_table_insert(m_tables, table, entry);
+    return entry;
+}
+
+void TableContext::resolveCell(AtkObject *cell, CellEntry &entry)
+{
+    AtkObject *tableObj = NULL;
+    AtkObject *rowObj = NULL;
+
+    // Find Table & Row Objects
+    AtkObject *obj = cell;
+    while(obj) {
+        obj = atk_object_get_parent(obj);
+        if(!obj)
+            break;
+
+        AtkRole role = atk_object_get_role(obj);
+        if(role == ATK_ROLE_TABLE) {
+            tableObj = obj;
+            break;
+        } else if(role == ATK_ROLE_TABLE_ROW) {
+            rowObj = obj;
+        }
+    }
+
+    entry.table = (tableObj && ATK_IS_TABLE(tableObj)) ? tableObj : NULL;
+    entry.row = rowObj;
+
+    // Note : this is not the not Row Header element, but the accessible name of Row element
+    entry.rowName = rowObj ? checkNullAndReturnStr(atk_object_get_name(rowObj)) : std::string();
+
+    entry.rowIndex = -1;
+    entry.columnIndex = -1;
+    if(ATK_IS_TABLE_CELL(cell)) {
+        gint row = -1, column = -1;
+        if(atk_table_cell_get_position(ATK_TABLE_CELL(cell), &row, &column)) {
+            entry.rowIndex = row;
+            entry.columnIndex = column;
+        }
+    }
+}
+
+TableContext::CellEntry* TableContext::cellEntry(AtkObject *cell)
+{
+    CellEntry *entry = static_cast<CellEntry*>(g_hash_table_lookup(m_cells, cell));
+    if(entry) {
+        TableEntry *table = entry->table ?
+            static_cast<TableEntry*>(g_hash_table_lookup(m_tables, entry->table)) : NULL;
+        if(table && table->generation == entry->generation) {
+            m_hits++;
+            return entry;
+        }
+    } else {
+        if(g_hash_table_size(m_cells) >= m_maxCells) {
+            RDKLOG_VERBOSE("Table cell cache is full (%u entries), flushing", m_maxCells);
+            clear();
+        }
+        entry = new CellEntry();
+        g_object_weak_ref(G_OBJECT(cell), CellFinalized, this);
+        g_hash_table_insert(m_cells, cell, entry);
+    }
+
+    m_misses++;
+    resolveCell(cell, *entry);
+    entry->generation = entry->table ? tableEntry(entry->table)->generation : 0;
+    return entry;
+}
+
+void TableContext::describe(AtkObject *obj, AtkRole role, std::string &prefix, std::string &position)
+{
+    // On focusing a non-cell element, forget previous cell details
+    if(role != ATK_ROLE_TABLE_CELL) {
+        forget();
+        return;
+    }
+
+    CellEntry *cell = cellEntry(obj);
+    if(!cell->table) {
+        forget();
+        return;
+    }
+    TableEntry *table = tableEntry(cell->table);
+
+    bool sameCell = (obj == m_lastCell);
+    bool tableChanged = (cell->table != m_lastTable);
+    bool rowChanged = tableChanged ||
+        (cell->rowIndex >= 0 ? cell->rowIndex != m_lastRowIndex : cell->row != m_lastRow);
+
+    // Retrieve Table Caption, only when entering the table or refocusing the same cell
+    if(sameCell || tableChanged) {
+        if(!table->captionResolved) {
+            AtkObject *captionObj = atk_table_get_caption(ATK_TABLE(cell->table));
+            table->caption = captionObj ? checkNullAndReturnStr(atk_object_get_name(captionObj)) : std::string();
+            table->captionResolved = true;
+        }
+        if(!table->caption.empty())
+            prefix = table->caption + ". ";
+    }
+
+    if(!cell->rowName.empty() && (sameCell || rowChanged))
+        prefix += cell->rowName + ". ";
+
+    if(cell->rowIndex >= 0 && cell->columnIndex >= 0) {
+        char buff[64];
+        if(sameCell || rowChanged) {
+            if(table->rows > 0)
+                snprintf(buff, sizeof(buff), "row %d of %d, column %d", cell->rowIndex + 1, table->rows, cell->columnIndex + 1);
+            else
+                snprintf(buff, sizeof(buff), "row %d, column %d", cell->rowIndex + 1, cell->columnIndex + 1);
+            position = buff;
+        } else if(cell->columnIndex != m_lastColumnIndex) {
+            snprintf(buff, sizeof(buff), "column %d", cell->columnIndex + 1);
+            position = buff;
+        }
+    }
+
+    // Remember Table information
+    track(&m_lastCell, obj);
+    track(&m_lastTable, cell->table);
+    track(&m_lastRow, cell->row);
+    m_lastRowIndex = cell->rowIndex;
+    m_lastColumnIndex = cell->columnIndex;
+}
+
+void TableContext::invalidateTable(AtkObject *table)
+{
+    if(g_hash_table_lookup(m_tables, table)) {
+        RDKLOG_VERBOSE("Table %p changed, invalidating its context", table);
+        g_object_weak_unref(G_OBJECT(table), TableFinalized, this);
+        g_hash_table_remove(m_tables, table);
+    }
+}
+
+void TableContext::nameChanged(AtkObject *obj)
+{
+    if(!g_hash_table_size(m_tables))
+        return;
+
+    AtkRole role = atk_object_get_role(obj);
+    if(role != ATK_ROLE_TABLE_ROW && role != ATK_ROLE_CAPTION)
+        return;
+
+    while((obj = atk_object_get_parent(obj))) {
+        if(atk_object_get_role(obj) == ATK_ROLE_TABLE) {
+            invalidateTable(obj);
+            break;
+        }
+    }
+}
+
+void TableContext::clear()
+{
+    GHashTableIter iter;
+    gpointer key;
+
+    g_hash_table_iter_init(&iter, m_cells);
+    while(g_hash_table_iter_next(&iter, &key, NULL))
+        g_object_weak_unref(G_OBJECT(key), CellFinalized, this);
+    g_hash_table_remove_all(m_cells);
+
+    g_hash_table_iter_init(&iter, m_tables);
+    while(g_hash_table_iter_next(&iter, &key, NULL))
+        g_object_weak_unref(G_OBJECT(key), TableFinalized, this);
+    g_hash_table_remove_all(m_tables);
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,117 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_TABLE_CONTEXT_H
+#define RDK_AT_TABLE_CONTEXT_H
+
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Table navigation context for focused cells.
+ *
+ * Caches, per table, its caption and dimensions and, per cell, its table,
+ * row ancestor and position, so that moving across a grid doesn't walk the
+ * parent chain again. Tables are invalidated on row / column / model changes
+ * and when their caption or one of their rows is renamed; cells of an
+ * invalidated table are refreshed lazily through a generation number. All
+ * objects are tracked through GObject weak references.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class TableContext {
+public:
+    TableContext();
+    ~TableContext();
+
+    /**
+     * @brief Describes the table context of a newly focused object.
+     * prefix receives the caption / row name when they changed since the
+     * previously focused cell, position receives "row N of M, column K"
+     * (or "column K" when staying on the same row).
+     * Focusing a non cell element forgets the previous cell.
+     */
+    void describe(AtkObject *obj, AtkRole role, std::string &prefix, std::string &position);
+
+    void invalidateTable(AtkObject *table);
+    // Invalidates the table whose cached caption or row name obj provides
+    void nameChanged(AtkObject *obj);
+    void clear();
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+private:
+    TableContext(const TableContext &);
+    TableContext& operator=(const TableContext &);
+
+    struct TableEntry {
+        uint64_t generation;
+        bool captionResolved;
+        std::string caption;
+        gint rows;
+        gint columns;
+    };
+
+    struct CellEntry {
+        AtkObject *table;    // weak, validated through the generation
+        uint64_t generation;
+        AtkObject *row;      // only compared
+        std::string rowName;
+        gint rowIndex;       // -1 when unknown
+        gint columnIndex;    // -1 when unknown
+    };
+
+    TableEntry* tableEntry(AtkObject *table);
+    CellEntry* cellEntry(AtkObject *cell);
+    void resolveCell(AtkObject *cell, CellEntry &entry);
+    void forget();
+    void track(AtkObject **slot, AtkObject *obj);
+
+    static void TableFinalized(gpointer data, GObject *obj);
+    static void CellFinalized(gpointer data, GObject *obj);
+    static void DestroyTableEntry(gpointer data);
+    static void DestroyCellEntry(gpointer data);
+
+    GHashTable *m_tables; // AtkObject* -> TableEntry*
+    GHashTable *m_cells;  // AtkObject* -> CellEntry*
+    guint m_maxCells;
+    uint64_t m_generation;
+
+    // Previously focused cell, weak pointers
+    AtkObject *m_lastCell;
+    AtkObject *m_lastTable;
+    AtkObject *m_lastRow;
+    gint m_lastRowIndex;
+    gint m_lastColumnIndex;
+
+    StatCounter m_hits;
+    StatCounter m_misses;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_TABLE_CONTEXT_H
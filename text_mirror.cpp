@@ -0,0 +1,237 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "text_mirror.h"
+#include "logger.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace RDK_AT
+{
+
+TextMirror::TextMirror() :
+    m_field(NULL),
+    m_length(0),
+    m_caret(0),
+    m_expectedCaret(0),
+    m_echoCharacters(true),
+    m_echoWords(true),
+    m_fetches(0),
+    m_edits(0),
+    m_resyncs(0),
+    m_echoes(0)
+{
+    const char *echo = getenv("RDKAT_TYPING_ECHO");
+    if(echo && *echo) {
+        m_echoCharacters = !strcmp(echo, "characters") || !strcmp(echo, "both");
+        m_echoWords = !strcmp(echo, "words") || !strcmp(echo, "both");
+        if(!m_echoCharacters && !m_echoWords && strcmp(echo, "none"))
+            RDKLOG_WARNING("Unknown RDKAT_TYPING_ECHO \"%s\", typing is not echoed", echo);
+    }
+}
+
+TextMirror::~TextMirror()
+{
+    track(NULL);
+}
+
+void TextMirror::FieldFinalized(gpointer data, GObject *)
+{
+    TextMirror *self = static_cast<TextMirror*>(data);
+    self->m_field = NULL;
+    self->fetch();
+}
+
+void TextMirror::track(AtkObject *field)
+{
+    if(field == m_field)
+        return;
+
+    if(m_field)
+        g_object_weak_unref(G_OBJECT(m_field), FieldFinalized, this);
+    m_field = field;
+    if(m_field)
+        g_object_weak_ref(G_OBJECT(m_field), FieldFinalized, this);
+    fetch();
+}
+
+void TextMirror::fetch()
+{
+    m_text.clear();
+    m_word.clear();
+    m_length = m_caret = m_expectedCaret = 0;
+    if(!m_field || !ATK_IS_TEXT(m_field))
+        return;
+
+    AtkText *text = ATK_TEXT(m_field);
+    gchar *s = atk_text_get_text(text, 0, -1);
+    if(s) {
+        m_text = s;
+        g_free(s);
+    }
+    m_length = g_utf8_strlen(m_text.c_str(), m_text.size());
+    m_caret = m_expectedCaret = atk_text_get_caret_offset(text);
+    m_fetches++;
+}
+
+void TextMirror::resync()
+{
+    RDKLOG_VERBOSE("Text mirror out of sync, length=%d, refetching", m_length);
+    m_resyncs++;
+    fetch();
+}
+
+size_t TextMirror::byteOffset(int offset) const
+{
+    return g_utf8_offset_to_pointer(m_text.c_str(), CLAMP(offset, 0, m_length)) - m_text.c_str();
+}
+
+void TextMirror::character(const char *begin, const char *end, std::string &utterance)
+{
+    if(g_unichar_isspace(g_utf8_get_char(begin)))
+        utterance = "space";
+    else
+        utterance.assign(begin, end);
+}
+
+bool TextMirror::inserted(int offset, const char *text, std::string &utterance)
+{
+    if(!text || !*text)
+        return false;
+    if(offset < 0 || offset > m_length) {
+        resync();
+        return false;
+    }
+
+    glong count = g_utf8_strlen(text, -1);
+    m_text.insert(byteOffset(offset), text);
+    m_length += count;
+    m_edits++;
+
+    // Typing somewhere else starts a new word
+    if(offset != m_expectedCaret)
+        m_word.clear();
+    m_caret = m_expectedCaret = offset + count;
+
+    utterance.clear();
+    if(count == 1) {
+        gunichar c = g_utf8_get_char(text);
+        if(isWordChar(c)) {
+            m_word += text;
+            if(m_echoCharacters)
+                utterance = text;
+        } else {
+            if(m_echoWords && !m_word.empty())
+                utterance = m_word;
+            else if(m_echoCharacters)
+                character(text, text + strlen(text), utterance);
+            m_word.clear();
+        }
+    } else {
+        // Pasted or auto completed, said as a whole
+        m_word.clear();
+        if(m_echoCharacters || m_echoWords)
+            utterance = text;
+    }
+
+    if(utterance.empty())
+        return false;
+    m_echoes++;
+    return true;
+}
+
+bool TextMirror::removed(int offset, int length, std::string &utterance)
+{
+    if(length <= 0)
+        return false;
+    if(offset < 0 || offset + length > m_length) {
+        resync();
+        return false;
+    }
+
+    size_t begin = byteOffset(offset), end = byteOffset(offset + length);
+    if(length == 1)
+        character(m_text.c_str() + begin, m_text.c_str() + end, utterance);
+    else
+        utterance.assign(m_text, begin, end - begin);
+
+    // Backspace takes the last character out of the word being typed
+    bool backspace = length == 1 && offset + 1 == m_expectedCaret;
+    if(backspace && !m_word.empty())
+        m_word.erase(g_utf8_find_prev_char(m_word.c_str(), m_word.c_str() + m_word.size()) - m_word.c_str());
+    else
+        m_word.clear();
+
+    m_text.erase(begin, end - begin);
+    m_length -= length;
+    m_caret = m_expectedCaret = offset;
+    m_edits++;
+
+    if(!m_echoCharacters)
+        return false;
+    m_echoes++;
+    return true;
+}
+
+bool TextMirror::caretMoved(int offset, std::string &utterance)
+{
+    // Moves made by editing aren't read
+    if(offset == m_expectedCaret || offset == m_caret) {
+        m_caret = offset;
+        return false;
+    }
+    if(offset < 0 || offset > m_length) {
+        resync();
+        return false;
+    }
+
+    int delta = offset - m_caret;
+    m_caret = m_expectedCaret = offset;
+    m_word.clear();
+
+    const char *text = m_text.c_str();
+    const char *caret = text + byteOffset(offset);
+    const char *textEnd = text + m_text.size();
+    utterance.clear();
+    if(delta == 1 || delta == -1) {
+        // Character at the caret
+        if(caret < textEnd)
+            character(caret, g_utf8_next_char(caret), utterance);
+    } else {
+        // Word around the caret
+        const char *begin = caret, *end = caret;
+        while(begin > text) {
+            const char *prev = g_utf8_prev_char(begin);
+            if(!isWordChar(g_utf8_get_char(prev)))
+                break;
+            begin = prev;
+        }
+        while(end < textEnd && isWordChar(g_utf8_get_char(end)))
+            end = g_utf8_next_char(end);
+        utterance.assign(begin, end);
+    }
+
+    if(utterance.empty())
+        return false;
+    m_echoes++;
+    return true;
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,92 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_TEXT_MIRROR_H
+#define RDK_AT_TEXT_MIRROR_H
+
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+
+#include <string>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Copy of the text of the focused editable field.
+ *
+ * The text is fetched once when focus settles on the field, then kept up to
+ * date from the offsets & strings text-insert / text-remove carry, so that
+ * typing and caret moves are echoed w/o querying WebKit again. An edit which
+ * doesn't fit the copy triggers a refetch.
+ *
+ * Echo is picked by RDKAT_TYPING_ECHO: "characters", "words", "both" (default)
+ * or "none". Words are made of the characters typed in a row and spoken once
+ * a separator is typed.
+ *
+ * Offsets are in characters, as in AtkText. Only to be used from the thread
+ * which emits ATK signals.
+ */
+class TextMirror {
+public:
+    TextMirror();
+    ~TextMirror();
+
+    void track(AtkObject *field); // NULL stops tracking
+    bool tracks(AtkObject *obj) const { return obj && obj == m_field; }
+
+    // Return true along with what to say
+    bool inserted(int offset, const char *text, std::string &utterance);
+    bool removed(int offset, int length, std::string &utterance);
+    bool caretMoved(int offset, std::string &utterance);
+
+    uint64_t fetches() const { return m_fetches; }
+    uint64_t edits() const { return m_edits; }
+    uint64_t resyncs() const { return m_resyncs; }
+    uint64_t echoes() const { return m_echoes; } // typing & caret utterances
+
+private:
+    TextMirror(const TextMirror &);
+    TextMirror& operator=(const TextMirror &);
+
+    void fetch();
+    void resync();
+    size_t byteOffset(int offset) const;
+    static void character(const char *begin, const char *end, std::string &utterance);
+    static bool isWordChar(gunichar c) { return g_unichar_isalnum(c) || c == '\'' || c == '_'; }
+    static void FieldFinalized(gpointer data, GObject *field);
+
+    AtkObject *m_field;
+    std::string m_text;
+    int m_length;        // in characters
+    int m_caret;
+    int m_expectedCaret; // where the last edit left the caret, its move is not read
+    std::string m_word;  // typed since the last separator
+    bool m_echoCharacters;
+    bool m_echoWords;
+    StatCounter m_fetches;
+    StatCounter m_edits;
+    StatCounter m_resyncs;
+    StatCounter m_echoes;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_TEXT_MIRROR_H
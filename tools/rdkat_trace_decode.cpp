@@ -0,0 +1,215 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/**
+ * Decodes a binary event trace written with RDKAT_TRACE_FILE.
+ *
+ * Usage: rdkat-trace-decode [--csv] <trace file>
+ *
+ * Text output has one line per record, times relative to the start of the
+ * trace. CSV output has one row per event / speak record with a header row.
+ */
+
+#include "event_trace_format.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+using namespace RDK_AT;
+
+namespace
+{
+
+static const char* const kClassNames[] = { "object", "window", "document", "focus" };
+
+struct Decoder {
+    bool csv;
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    std::vector<uint16_t> objectRoles;
+
+    Decoder() : csv(false) { }
+
+    const char* name(uint16_t id) const
+    {
+        return id < names.size() ? names[id].c_str() : "";
+    }
+
+    const char* role(uint32_t object) const
+    {
+        return object < objectRoles.size() ? name(objectRoles[object]) : "";
+    }
+
+    std::string value(const TraceRecord &r) const
+    {
+        char buff[32];
+        switch(r.klassAndValueType & 0x0F) {
+        case 1: // int
+            snprintf(buff, sizeof(buff), "%d", (int32_t)r.value);
+            return buff;
+        case 2: // string
+            if(r.value == kTraceNoId)
+                return "<not recorded>";
+            return r.value < values.size() ? values[r.value] : std::string();
+        case 3: // object
+            if(r.value == kTraceNoId)
+                return std::string();
+            snprintf(buff, sizeof(buff), "#%u", r.value);
+            return buff;
+        default:
+            return std::string();
+        }
+    }
+};
+
+std::string csvQuote(const std::string &s)
+{
+    std::string out = "\"";
+    for(char c : s) {
+        if(c == '"')
+            out += '"';
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+bool readString(FILE *f, const TraceRecord &r, std::string &out)
+{
+    size_t length = r.d1 > 0 ? (size_t)r.d1 : 0;
+    size_t blocks = (length + sizeof(TraceRecord) - 1) / sizeof(TraceRecord);
+    std::vector<char> data(blocks * sizeof(TraceRecord));
+    if(blocks && fread(data.data(), sizeof(TraceRecord), blocks, f) != blocks)
+        return false;
+    out.assign(data.data(), length);
+    return true;
+}
+
+void store(std::vector<std::string> &table, uint32_t id, const std::string &s)
+{
+    if(id >= table.size())
+        table.resize(id + 1);
+    table[id] = s;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Decoder decoder;
+    const char *path = NULL;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--csv") == 0)
+            decoder.csv = true;
+        else
+            path = argv[i];
+    }
+
+    if(!path) {
+        fprintf(stderr, "Usage: %s [--csv] <trace file>\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if(!f) {
+        perror(path);
+        return 1;
+    }
+
+    TraceFileHeader header;
+    if(fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, kTraceMagic, sizeof(kTraceMagic)) != 0) {
+        fprintf(stderr, "%s: not an rdkat trace\n", path);
+        fclose(f);
+        return 1;
+    }
+
+    if(header.version != kTraceVersion || header.recordSize != sizeof(TraceRecord)) {
+        fprintf(stderr, "%s: unsupported trace version %u (record size %u)\n", path, header.version, header.recordSize);
+        fclose(f);
+        return 1;
+    }
+
+    if(decoder.csv)
+        printf("time_ns,kind,object,role,class,major,minor,d1,d2,value\n");
+    else
+        printf("# trace started at %llu.%09llu (realtime)\n",
+            (unsigned long long)(header.startRealtimeNs / 1000000000ULL),
+            (unsigned long long)(header.startRealtimeNs % 1000000000ULL));
+
+    unsigned long long events = 0, speaks = 0;
+    TraceRecord r;
+    while(fread(&r, sizeof(r), 1, f) == 1) {
+        const unsigned long long t = r.timestampNs - header.startMonotonicNs;
+
+        if(r.kind == TRACE_RECORD_STRING) {
+            std::string s;
+            if(!readString(f, r, s)) {
+                fprintf(stderr, "%s: truncated string definition\n", path);
+                break;
+            }
+            store(r.d2 == TRACE_STRINGS_VALUES ? decoder.values : decoder.names, r.value, s);
+        } else if(r.kind == TRACE_RECORD_OBJECT) {
+            if(r.object >= decoder.objectRoles.size())
+                decoder.objectRoles.resize(r.object + 1, kTraceNoName);
+            decoder.objectRoles[r.object] = (uint16_t)r.value;
+        } else if(r.kind == TRACE_RECORD_EVENT) {
+            const unsigned klass = r.klassAndValueType >> 4;
+            const char *klassName = klass < sizeof(kClassNames) / sizeof(kClassNames[0]) ? kClassNames[klass] : "";
+            const std::string value = decoder.value(r);
+            events++;
+
+            if(decoder.csv) {
+                printf("%llu,event,%d,%s,%s,%s,%s,%d,%d,%s\n", t,
+                    r.object == kTraceNoId ? -1 : (int)r.object,
+                    csvQuote(decoder.role(r.object)).c_str(), klassName,
+                    csvQuote(decoder.name(r.majorName)).c_str(), csvQuote(decoder.name(r.minorName)).c_str(),
+                    r.d1, r.d2, csvQuote(value).c_str());
+            } else {
+                printf("%10llu.%06llu event #%u (%s) %s %s%s%s d1=%d d2=%d%s%s\n",
+                    t / 1000000000ULL, (t % 1000000000ULL) / 1000ULL,
+                    r.object, decoder.role(r.object), klassName, decoder.name(r.majorName),
+                    r.minorName != kTraceNoName ? ":" : "", decoder.name(r.minorName),
+                    r.d1, r.d2, value.empty() ? "" : " value=", value.c_str());
+            }
+        } else if(r.kind == TRACE_RECORD_SPEAK) {
+            speaks++;
+            if(decoder.csv) {
+                printf("%llu,speak,%d,%s,,,,%d,0,\n", t,
+                    r.object == kTraceNoId ? -1 : (int)r.object,
+                    csvQuote(decoder.role(r.object)).c_str(), r.d1);
+            } else {
+                printf("%10llu.%06llu speak #%u (%s) length=%d\n",
+                    t / 1000000000ULL, (t % 1000000000ULL) / 1000ULL,
+                    r.object, decoder.role(r.object), r.d1);
+            }
+        } else {
+            fprintf(stderr, "%s: unknown record kind %u, stopping\n", path, r.kind);
+            break;
+        }
+    }
+
+    if(!decoder.csv)
+        printf("# %llu events, %llu utterances, %zu objects\n", events, speaks, decoder.objectRoles.size());
+
+    fclose(f);
+    return 0;
+}
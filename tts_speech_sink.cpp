@@ -0,0 +1,162 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "tts_speech_sink.h"
+#include "logger.h"
+
+#include <glib.h>
+
+namespace RDK_AT
+{
+
+TTSSpeechSink::TTSSpeechSink() :
+    m_listener(NULL),
+    m_ttsClient(NULL),
+    m_appId(GPOINTER_TO_UINT(this)),
+    m_sessionId(0),
+    m_connected(false)
+{
+}
+
+TTSSpeechSink::~TTSSpeechSink()
+{
+    closeSession();
+    if(m_ttsClient) {
+        delete m_ttsClient;
+        m_ttsClient = NULL;
+    }
+}
+
+bool TTSSpeechSink::connect(SpeechSinkListener *listener)
+{
+    if(m_ttsClient)
+        return true;
+
+    m_listener = listener;
+    m_ttsClient = TTS::TTSClient::create(this);
+    return m_ttsClient != NULL;
+}
+
+bool TTSSpeechSink::openSession()
+{
+    if(!m_ttsClient)
+        return false;
+
+    if(m_sessionId == 0)
+        m_sessionId = m_ttsClient->createSession(m_appId, "WPE", this);
+    return m_sessionId != 0;
+}
+
+void TTSSpeechSink::closeSession()
+{
+    if(m_sessionId == 0)
+        return;
+
+    // The session died with the server, nothing to tear down
+    if(m_ttsClient && m_connected) {
+        m_ttsClient->abort(m_sessionId);
+        m_ttsClient->destroySession(m_sessionId);
+    }
+    m_sessionId = 0;
+}
+
+bool TTSSpeechSink::isActive()
+{
+    return m_ttsClient && m_sessionId && m_ttsClient->isActiveSession(m_sessionId);
+}
+
+bool TTSSpeechSink::speak(uint32_t speechId, std::string &text)
+{
+    if(!m_ttsClient || !m_sessionId)
+        return false;
+
+    TTS::SpeechData d;
+    d.id = speechId;
+    d.text = std::move(text);
+    return m_ttsClient->speak(m_sessionId, d) == TTS::TTS_OK;
+}
+
+void TTSSpeechSink::abort()
+{
+    if(m_ttsClient && m_sessionId)
+        m_ttsClient->abort(m_sessionId);
+}
+
+void TTSSpeechSink::onTTSServerConnected()
+{
+    RDKLOG_INFO("Connection to TTSManager got established");
+    m_connected = true;
+    m_listener->onSinkConnected();
+}
+
+void TTSSpeechSink::onTTSServerClosed()
+{
+    RDKLOG_ERROR("Connection to TTSManager got closed!!!");
+    m_connected = false;
+    m_listener->onSinkClosed();
+}
+
+void TTSSpeechSink::onTTSStateChanged(bool enabled)
+{
+    m_listener->onSinkStateChanged(enabled);
+}
+
+void TTSSpeechSink::onResourceAcquired(uint32_t appId, uint32_t sessionId)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d", appId, sessionId);
+    m_listener->onSessionReady();
+}
+
+void TTSSpeechSink::onSpeechStart(uint32_t appid, uint32_t sessionid, TTS::SpeechData &data)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d, text=%s", appid, sessionid, data.id, data.text.c_str());
+    m_listener->onSpeechStarted(data.id);
+}
+
+void TTSSpeechSink::onNetworkError(uint32_t appId, uint32_t sessionId, uint32_t speechId)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d", appId, sessionId, speechId);
+    m_listener->onSpeechFinished(speechId, SPEECH_FAILED);
+}
+
+void TTSSpeechSink::onPlaybackError(uint32_t appId, uint32_t sessionId, uint32_t speechId)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d", appId, sessionId, speechId);
+    m_listener->onSpeechFinished(speechId, SPEECH_FAILED);
+}
+
+void TTSSpeechSink::onSpeechInterrupted(uint32_t appId, uint32_t sessionId, uint32_t speechId)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d", appId, sessionId, speechId);
+    m_listener->onSpeechFinished(speechId, SPEECH_INTERRUPTED);
+}
+
+void TTSSpeechSink::onSpeechCancelled(uint32_t appId, uint32_t sessionId, uint32_t speechId)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d", appId, sessionId, speechId);
+    m_listener->onSpeechFinished(speechId, SPEECH_CANCELLED);
+}
+
+void TTSSpeechSink::onSpeechComplete(uint32_t appid, uint32_t sessionid, TTS::SpeechData &data)
+{
+    RDKLOG_INFO("appid=%d, sessionid=%d, speechid=%d, text=%s", appid, sessionid, data.id, data.text.c_str());
+    m_listener->onSpeechFinished(data.id, SPEECH_COMPLETED);
+}
+
+} // namespace RDK_AT
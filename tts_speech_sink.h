@@ -0,0 +1,76 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_TTS_SPEECH_SINK_H
+#define RDK_AT_TTS_SPEECH_SINK_H
+
+#include "speech_sink.h"
+#include "TTSClient.h"
+
+#include <atomic>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief SpeechSink backed by TTSManager, through the TTSClient IPC library.
+ */
+class TTSSpeechSink : public SpeechSink, public TTS::TTSConnectionCallback, public TTS::TTSSessionCallback {
+public:
+    TTSSpeechSink();
+    ~TTSSpeechSink();
+
+    const char* name() const { return "tts"; }
+
+    bool connect(SpeechSinkListener *listener);
+    bool openSession();
+    void closeSession();
+    bool isActive();
+    bool speak(uint32_t speechId, std::string &text);
+    void abort();
+
+    // TTS Connection Callbacks
+    virtual void onTTSServerConnected();
+    virtual void onTTSServerClosed();
+    virtual void onTTSStateChanged(bool enabled);
+
+    // TTS Session Callbacks
+    virtual void onTTSSessionCreated(uint32_t, uint32_t) {};
+    virtual void onResourceAcquired(uint32_t appId, uint32_t sessionId);
+    virtual void onResourceReleased(uint32_t, uint32_t) {};
+    virtual void onSpeechStart(uint32_t appid, uint32_t sessionid, TTS::SpeechData &data);
+    virtual void onNetworkError(uint32_t appId, uint32_t sessionId, uint32_t speechId);
+    virtual void onPlaybackError(uint32_t appId, uint32_t sessionId, uint32_t speechId);
+    virtual void onSpeechInterrupted(uint32_t appId, uint32_t sessionId, uint32_t speechId);
+    virtual void onSpeechCancelled(uint32_t appId, uint32_t sessionId, uint32_t speechId);
+    virtual void onSpeechComplete(uint32_t appid, uint32_t sessionid, TTS::SpeechData &data);
+
+private:
+    TTSSpeechSink(const TTSSpeechSink &);
+    TTSSpeechSink& operator=(const TTSSpeechSink &);
+
+    SpeechSinkListener *m_listener;
+    TTS::TTSClient *m_ttsClient;
+    uint32_t m_appId;
+    uint32_t m_sessionId;
+    std::atomic<bool> m_connected; // cleared from the TTS thread when TTSManager goes away
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_TTS_SPEECH_SINK_H
@@ -0,0 +1,108 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "utterance_cache.h"
+#include "logger.h"
+
+#include <stdlib.h>
+
+namespace RDK_AT
+{
+
+static const guint kDefaultMaxEntries = 256;
+
+UtteranceCache::UtteranceCache() :
+    m_entries(g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, DestroyEntry)),
+    m_maxEntries(kDefaultMaxEntries),
+    m_hits(0),
+    m_misses(0),
+    m_invalidations(0)
+{
+    const char *size = getenv("RDKAT_UTTERANCE_CACHE_SIZE");
+    if(size)
+        m_maxEntries = atoi(size);
+}
+
+UtteranceCache::~UtteranceCache()
+{
+    clear();
+    g_hash_table_destroy(m_entries);
+}
+
+void UtteranceCache::DestroyEntry(gpointer data)
+{
+    delete static_cast<std::string*>(data);
+}
+
+void UtteranceCache::ObjectFinalized(gpointer data, GObject *obj)
+{
+    UtteranceCache *self = static_cast<UtteranceCache*>(data);
+    g_hash_table_remove(self->m_entries, obj);
+}
+
+const std::string* UtteranceCache::lookup(AtkObject *obj)
+{
+    const std::string *text = static_cast<const std::string*>(g_hash_table_lookup(m_entries, obj));
+    if(text)
+        m_hits++;
+    else
+        m_misses++;
+    return text;
+}
+
+void UtteranceCache::insert(AtkObject *obj, const std::string &text)
+{
+    if(m_maxEntries == 0)
+        return;
+
+    std::string *entry = static_cast<std::string*>(g_hash_table_lookup(m_entries, obj));
+    if(entry) {
+        *entry = text;
+        return;
+    }
+
+    // Bounded w/o LRU bookkeeping, a focus path is rebuilt quickly anyway
+    if(g_hash_table_size(m_entries) >= m_maxEntries) {
+        RDKLOG_VERBOSE("Utterance cache is full (%u entries), flushing", m_maxEntries);
+        clear();
+    }
+
+    g_object_weak_ref(G_OBJECT(obj), ObjectFinalized, this);
+    g_hash_table_insert(m_entries, obj, new std::string(text));
+}
+
+void UtteranceCache::invalidate(AtkObject *obj)
+{
+    if(g_hash_table_remove(m_entries, obj)) {
+        g_object_weak_unref(G_OBJECT(obj), ObjectFinalized, this);
+        m_invalidations++;
+    }
+}
+
+void UtteranceCache::clear()
+{
+    GHashTableIter iter;
+    gpointer key;
+    g_hash_table_iter_init(&iter, m_entries);
+    while(g_hash_table_iter_next(&iter, &key, NULL))
+        g_object_weak_unref(G_OBJECT(key), ObjectFinalized, this);
+    g_hash_table_remove_all(m_entries);
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,74 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_UTTERANCE_CACHE_H
+#define RDK_AT_UTTERANCE_CACHE_H
+
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief Composed speech text per AtkObject.
+ *
+ * Entries are held through GObject weak references, so a finalized object
+ * drops its entry, and are invalidated on name / description / role / checked
+ * changes. Computing the accessible name may walk the DOM in WebKit, so
+ * revisiting an element should not pay for it again.
+ *
+ * Only to be used from the thread which emits ATK signals.
+ */
+class UtteranceCache {
+public:
+    UtteranceCache();
+    ~UtteranceCache();
+
+    const std::string* lookup(AtkObject *obj);
+    void insert(AtkObject *obj, const std::string &text);
+    void invalidate(AtkObject *obj);
+    void clear();
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    uint64_t invalidations() const { return m_invalidations; }
+    guint size() const { return g_hash_table_size(m_entries); }
+
+private:
+    UtteranceCache(const UtteranceCache &);
+    UtteranceCache& operator=(const UtteranceCache &);
+
+    static void ObjectFinalized(gpointer data, GObject *obj);
+    static void DestroyEntry(gpointer data);
+
+    GHashTable *m_entries; // AtkObject* -> std::string*
+    guint m_maxEntries;
+    StatCounter m_hits;
+    StatCounter m_misses;
+    StatCounter m_invalidations;
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_UTTERANCE_CACHE_H
@@ -0,0 +1,205 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "view_context.h"
+#include "logger.h"
+
+namespace RDK_AT
+{
+
+static unsigned gNextContextId = 1;
+
+ViewContext::ViewContext(AtkObject *root) :
+    m_root(root),
+    m_id(root ? gNextContextId++ : 0),
+    m_process(false),
+    m_lastFocus(NULL),
+    m_focusAbortPosted(false),
+    m_lastTextObj(NULL)
+{
+    if(m_root)
+        g_object_ref(m_root);
+}
+
+ViewContext::~ViewContext()
+{
+    stop();
+    if(m_root)
+        g_object_unref(m_root);
+}
+
+void ViewContext::start(GMainContext *mainContext, SpeechDispatcher::TTSStateCallback ttsCB, void *ttsCBData,
+        FocusCoalescer::SettledCallback settledCB, LiveRegions::AnnounceCallback announceCB)
+{
+    m_speech.start(ttsCB, ttsCBData);
+    m_focusCoalescer.start(mainContext, settledCB, this);
+    m_liveRegions.start(mainContext, announceCB, this);
+}
+
+void ViewContext::stop()
+{
+    m_liveRegions.stop();
+    m_focusCoalescer.stop();
+    m_speech.stop();
+}
+
+void ViewContext::enableProcessing(bool enable)
+{
+    RDKLOG_INFO("context=%u, processingEnabled=%d, enable=%d", m_id, m_process, enable);
+    m_process = enable;
+
+    // The dispatcher connected from start(), this opens the session in the background
+    m_speech.enableProcessing(enable);
+    // Events aren't handled until re-enabled, nothing would invalidate the caches
+    if(!enable) {
+        m_focusCoalescer.cancel();
+        clearCaches();
+    }
+}
+
+void ViewContext::setVolumeControlCallback(MediaVolumeControlCallback cb, void *data)
+{
+    m_speech.setVolumeControlCallback(cb, data);
+}
+
+void ViewContext::focusChanged(AtkObject *obj, uint64_t eventNs)
+{
+    if(obj != m_lastFocus && !m_focusAbortPosted) {
+        m_speech.abort();
+        m_focusAbortPosted = true;
+    }
+    m_focusCoalescer.push(obj, eventNs);
+}
+
+void ViewContext::focusSettled(AtkObject *obj)
+{
+    m_lastFocus = obj;
+    m_focusAbortPosted = false;
+}
+
+bool ViewContext::speak(AtkObject *obj, const std::string &text, SpeechPriority priority, uint64_t eventNs, bool dedupe)
+{
+    if(text.empty())
+        return false;
+
+    if(!dedupe) {
+        m_speech.speak(text, priority, eventNs);
+        m_lastText.clear();
+        m_lastTextObj = NULL;
+        return true;
+    }
+
+    //it is temporary fix to Skip the duplication Text for YouTubeApp
+    bool duplicate = text == m_lastText && obj == m_lastTextObj;
+    if(duplicate)
+        RDKLOG_VERBOSE("Skipping the duplication Text : \"%s\"", text.c_str());
+    else
+        m_speech.speak(text, priority, eventNs);
+
+    m_lastText = text;
+    m_lastTextObj = obj;
+    return !duplicate;
+}
+
+void ViewContext::clearCaches()
+{
+    m_utteranceCache.clear();
+    m_tableContext.clear();
+    m_textMirror.track(NULL);
+    m_liveRegions.clear();
+}
+
+void ViewContext::statistics(StatsWriter &w) const
+{
+    const SpeechLatency &latency = m_speech.latency();
+    w.beginObject("speech_latency");
+    w.histogram("accessibility", latency.accessibility);
+    w.histogram("dispatch", latency.dispatch);
+    w.histogram("sink_call", latency.sinkCall);
+    w.histogram("synthesis", latency.synthesis);
+    w.histogram("playback", latency.playback);
+    w.histogram("first_audio", latency.firstAudio);
+    w.endObject();
+
+    w.beginObject("speech");
+    w.field("tts_enabled", m_speech.ttsEnabled());
+    w.field("ready", m_speech.ready());
+    w.field("time_to_ready_us", (int64_t)m_speech.timeToReadyUs());
+    w.field("connection", connectionStateName(m_speech.connectionState()));
+    w.field("connect_attempts", m_speech.connectAttempts());
+    w.field("disconnects", m_speech.disconnects());
+    w.field("reconnects", m_speech.reconnects());
+    w.field("queue_depth", (uint64_t)m_speech.queueDepth());
+    w.field("max_queue_depth", (uint64_t)m_speech.maxQueueDepth());
+    w.field("dropped", m_speech.droppedCount());
+    w.field("spoken", m_speech.spokenCount());
+    w.field("aborted", m_speech.abortedCount());
+    w.field("last_queue_latency_us", (int64_t)m_speech.lastLatencyUs());
+    w.field("max_queue_latency_us", (int64_t)m_speech.maxLatencyUs());
+    w.field("total_queue_latency_us", (int64_t)m_speech.totalLatencyUs());
+    w.endObject();
+
+    const SpeechScheduler &scheduler = m_speech.scheduler();
+    w.beginObject("scheduler");
+    w.field("pending", scheduler.size());
+    w.field("replaced", scheduler.replacedCount());
+    w.field("overflowed", scheduler.overflowCount());
+    w.field("interrupts", scheduler.interruptCount());
+    w.field("stale", scheduler.staleCount());
+    w.endObject();
+
+    const DuckingController &ducking = m_speech.ducking();
+    w.beginObject("ducking");
+    w.field("ducks", ducking.duckCount());
+    w.field("releases", ducking.releaseCount());
+    w.field("volume_callbacks", ducking.callbackCount());
+    w.endObject();
+
+    w.beginObject("focus");
+    w.field("superseded", m_focusCoalescer.supersededCount());
+    w.field("settled", m_focusCoalescer.settledCount());
+    w.endObject();
+
+    w.beginObject("utterance_cache");
+    w.field("hits", m_utteranceCache.hits());
+    w.field("misses", m_utteranceCache.misses());
+    w.field("invalidations", m_utteranceCache.invalidations());
+    w.endObject();
+
+    w.beginObject("table_context");
+    w.field("hits", m_tableContext.hits());
+    w.field("misses", m_tableContext.misses());
+    w.endObject();
+
+    w.beginObject("text_mirror");
+    w.field("fetches", m_textMirror.fetches());
+    w.field("edits", m_textMirror.edits());
+    w.field("resyncs", m_textMirror.resyncs());
+    w.field("echoes", m_textMirror.echoes());
+    w.endObject();
+
+    w.beginObject("live_regions");
+    w.field("attribute_fetches", m_liveRegions.attributeFetches());
+    w.field("updates", m_liveRegions.updates());
+    w.field("coalesced", m_liveRegions.coalesced());
+    w.field("announcements", m_liveRegions.announcements());
+    w.endObject();
+}
+
+} // namespace RDK_AT
@@ -0,0 +1,104 @@
+/*
+ * If not stated otherwise in this file or this component's Licenses.txt file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2017 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef RDK_AT_VIEW_CONTEXT_H
+#define RDK_AT_VIEW_CONTEXT_H
+
+#include "rdkat.h"
+#include "speech_dispatcher.h"
+#include "focus_coalescer.h"
+#include "utterance_cache.h"
+#include "table_context.h"
+#include "text_mirror.h"
+#include "live_regions.h"
+#include "statistics.h"
+
+#include <glib.h>
+#include <atk/atk.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace RDK_AT
+{
+
+/**
+ * @brief State of one view, i.e. of the accessible tree below a root object.
+ *
+ * Each context has its own speech dispatcher, hence its own TTS session and
+ * speech queue, and its own focus, utterance, table, text & live region state, so that views
+ * sharing the process neither interrupt nor dedupe each other. The default
+ * context has no root, it gets the events no other context claims.
+ *
+ * Only to be used from the thread which emits ATK signals, the speech
+ * observers excepted.
+ */
+class ViewContext {
+public:
+    explicit ViewContext(AtkObject *root); // NULL for the default context, referenced otherwise
+    ~ViewContext();
+
+    void start(GMainContext *mainContext, SpeechDispatcher::TTSStateCallback ttsCB, void *ttsCBData,
+            FocusCoalescer::SettledCallback settledCB, LiveRegions::AnnounceCallback announceCB);
+    void stop();
+
+    void enableProcessing(bool enable);
+    bool processingEnabled() const { return m_process; }
+    void setVolumeControlCallback(MediaVolumeControlCallback cb, void *data);
+
+    // Interrupts the speech about the element focus moves away from, once per burst
+    void focusChanged(AtkObject *obj, uint64_t eventNs);
+    void focusSettled(AtkObject *obj);
+    // Returns false when dedupe is set and text repeats the previous utterance about obj.
+    // Typing echo, caret reads and live region announcements repeat legitimately, they
+    // pass dedupe=false and reset the previous utterance
+    bool speak(AtkObject *obj, const std::string &text, SpeechPriority priority, uint64_t eventNs, bool dedupe = true);
+    void clearCaches();
+
+    AtkObject* root() const { return m_root; }
+    unsigned id() const { return m_id; }
+    SpeechDispatcher& speech() { return m_speech; }
+    UtteranceCache& utteranceCache() { return m_utteranceCache; }
+    TableContext& tableContext() { return m_tableContext; }
+    TextMirror& textMirror() { return m_textMirror; }
+    LiveRegions& liveRegions() { return m_liveRegions; }
+
+    void statistics(StatsWriter &w) const;
+
+private:
+    ViewContext(const ViewContext &);
+    ViewContext& operator=(const ViewContext &);
+
+    AtkObject *m_root;
+    unsigned m_id;
+    bool m_process;
+    SpeechDispatcher m_speech;
+    FocusCoalescer m_focusCoalescer;
+    UtteranceCache m_utteranceCache;
+    TableContext m_tableContext;
+    TextMirror m_textMirror;
+    LiveRegions m_liveRegions;
+    AtkObject *m_lastFocus; // only compared, never dereferenced
+    bool m_focusAbortPosted;
+    std::string m_lastText;
+    AtkObject *m_lastTextObj; // only compared, never dereferenced
+};
+
+} // namespace RDK_AT
+
+#endif // RDK_AT_VIEW_CONTEXT_H